@@ -0,0 +1,185 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace keypop {
+namespace calypso {
+namespace card {
+
+/**
+ * Non-owning, read-only view of a contiguous sequence of elements (pointer + length).
+ *
+ * <p>An {@code ArrayView} never allocates and never copies the viewed elements. It can be built
+ * from a raw pointer and a length, a C array, a {@code std::array} or a {@code std::vector}.
+ * Braced lists always convert to the {@code std::vector} overloads of an API, never to a view.
+ *
+ * <p>Caution: the viewed storage must outlive the view. When a view is passed to a "prepare"
+ * method, the data is consumed before the method returns and the storage may be released
+ * afterwards.
+ *
+ * @param <T> The type of the viewed elements.
+ * @since 2.0.0
+ */
+template <typename T>
+class ArrayView final {
+public:
+    /**
+     * Creates a view on the provided memory area.
+     *
+     * <p>This constructor only accepts pointer types, so that a braced list of integers such as
+     * {@code {0x00, 0x05}} never converts to a view. There is deliberately no default
+     * constructor either: the "prepare" methods of TransactionManager overload a {@code
+     * std::vector} parameter with a view parameter, and an empty braced list {@code {}} would be
+     * ambiguous between them. Use {@code ArrayView(nullptr, 0)} to create an empty view.
+     *
+     * @param data A pointer to the first element (may be null only if size is 0).
+     * @param size The number of elements.
+     * @since 2.0.0
+     */
+    template <
+        typename P,
+        typename = typename std::enable_if<std::is_convertible<P, const T*>::value>::type>
+    ArrayView(const P data, const size_t size) : mData(data), mSize(size) {}
+
+    /**
+     * Creates a view on the provided C array.
+     *
+     * @param data The array.
+     * @since 2.0.0
+     */
+    template <size_t N>
+    ArrayView(const T (&data)[N]) : mData(data), mSize(N) {}
+
+    /**
+     * Creates a view on the provided array.
+     *
+     * @param data The array.
+     * @since 2.0.0
+     */
+    template <size_t N>
+    ArrayView(const std::array<T, N>& data) : mData(data.data()), mSize(N) {}
+
+    /**
+     * Creates a view on the provided vector.
+     *
+     * <p>The view is invalidated by any operation that reallocates the vector.
+     *
+     * @param data The vector.
+     * @since 2.0.0
+     */
+    ArrayView(const std::vector<T>& data) : mData(data.data()), mSize(data.size()) {}
+
+    /**
+     * Gets a pointer to the first element.
+     *
+     * @return Null if the view is empty and has been created without storage.
+     * @since 2.0.0
+     */
+    const T*
+    data() const {
+        return mData;
+    }
+
+    /**
+     * Gets the number of elements.
+     *
+     * @return A positive or zero value.
+     * @since 2.0.0
+     */
+    size_t
+    size() const {
+        return mSize;
+    }
+
+    /**
+     * Indicates whether the view is empty.
+     *
+     * @return True if the view contains no element.
+     * @since 2.0.0
+     */
+    bool
+    empty() const {
+        return mSize == 0;
+    }
+
+    /**
+     * Gets an iterator on the first element.
+     *
+     * @since 2.0.0
+     */
+    const T*
+    begin() const {
+        return mData;
+    }
+
+    /**
+     * Gets an iterator past the last element.
+     *
+     * @since 2.0.0
+     */
+    const T*
+    end() const {
+        return mData + mSize;
+    }
+
+    /**
+     * Gets the element at the provided index (no bounds checking).
+     *
+     * @param index The index of the element, lower than size().
+     * @return A reference to the element.
+     * @since 2.0.0
+     */
+    const T&
+    operator[](const size_t index) const {
+        return mData[index];
+    }
+
+    /**
+     * Returns a copy of the viewed elements.
+     *
+     * <p>This method allocates; it is provided for interoperability with APIs requiring owned
+     * data.
+     *
+     * @return A new vector.
+     * @since 2.0.0
+     */
+    std::vector<T>
+    toVector() const {
+        return std::vector<T>(begin(), end());
+    }
+
+private:
+    /**
+     *
+     */
+    const T* mData;
+
+    /**
+     *
+     */
+    size_t mSize;
+};
+
+/**
+ * Non-owning, read-only view of a byte sequence.
+ *
+ * @since 2.0.0
+ */
+using ByteArrayView = ArrayView<uint8_t>;
+
+} /* namespace card */
+} /* namespace calypso */
+} /* namespace keypop */
@@ -11,18 +11,35 @@
 
 #include <memory>
 
+#include "keypop/calypso/card/ArrayView.hpp"
 #include "keypop/calypso/card/card/CalypsoCard.hpp"
 #include "keypop/calypso/card/card/CalypsoCardSelectionExtension.hpp"
+#include "keypop/calypso/card/card/ReadAheadProfile.hpp"
+#include "keypop/calypso/card/transaction/FreeTransactionManager.hpp"
 #include "keypop/calypso/card/transaction/SearchCommandData.hpp"
 #include "keypop/calypso/card/transaction/SecureExtendedModeTransactionManager.hpp"
+#include "keypop/calypso/card/transaction/SecureRegularModeTransactionManager.hpp"
 #include "keypop/calypso/card/transaction/SymmetricCryptoSecuritySetting.hpp"
+#include "keypop/calypso/card/transaction/TransactionPlan.hpp"
 #include "keypop/calypso/card/transaction/spi/SymmetricCryptoCardTransactionManagerFactory.hpp"
-#include "keypop/calypso/reader/CardReader.hpp"
+#include "keypop/reader/CardReader.hpp"
 
 namespace keypop {
 namespace calypso {
 namespace card {
 
+using keypop::calypso::card::card::CalypsoCard;
+using keypop::calypso::card::card::CalypsoCardSelectionExtension;
+using keypop::calypso::card::card::ReadAheadProfile;
+using keypop::calypso::card::transaction::FreeTransactionManager;
+using keypop::calypso::card::transaction::SearchCommandData;
+using keypop::calypso::card::transaction::SecureExtendedModeTransactionManager;
+using keypop::calypso::card::transaction::SecureRegularModeTransactionManager;
+using keypop::calypso::card::transaction::SymmetricCryptoSecuritySetting;
+using keypop::calypso::card::transaction::TransactionPlan;
+using keypop::calypso::card::transaction::spi::SymmetricCryptoCardTransactionManagerFactory;
+using keypop::reader::CardReader;
+
 /**
  * Calypso Card API Factory.
  *
@@ -39,6 +56,30 @@ public:
     virtual std::shared_ptr<CalypsoCardSelectionExtension> createCalypsoCardSelectionExtension()
         = 0;
 
+    /**
+     * Returns a new instance of ReadAheadProfile.
+     *
+     * @return A new instance of ReadAheadProfile.
+     * @see CalypsoCardSelectionExtension#addReadAheadProfile(uint8_t, uint8_t, std::shared_ptr)
+     * @since 2.0.0
+     */
+    virtual std::shared_ptr<ReadAheadProfile> createReadAheadProfile() = 0;
+
+    /**
+     * Returns a new instance of CalypsoCard restored from a snapshot.
+     *
+     * <p>The restored card holds the same data as the card at the time of the export, and can be
+     * used as a card image without any card communication.
+     *
+     * @param snapshot The snapshot, as produced by {@link CalypsoCard#exportSnapshot(std::vector&)}
+     *        (the storage can be released after the call).
+     * @return A new instance of CalypsoCard.
+     * @throw IllegalArgumentException If the snapshot is truncated, malformed, or has an
+     *        unsupported format version (see {@link CardSnapshot}).
+     * @since 2.0.0
+     */
+    virtual std::shared_ptr<CalypsoCard> restoreCalypsoCard(const ByteArrayView snapshot) = 0;
+
     /**
      * Returns a new instance of SymmetricCryptoSecuritySetting.
      *
@@ -51,19 +92,19 @@ public:
     virtual std::shared_ptr<SymmetricCryptoSecuritySetting> createSymmetricCryptoSecuritySetting(
         const std::shared_ptr<SymmetricCryptoCardTransactionManagerFactory>
             cryptoCardTransactionManagerFactory)
-        = 0
-
-        /**
-         * Returns a new instance of FreeTransactionManager.
-         *
-         * @param cardReader The card reader to be used.
-         * @param card The selected card on which to operate the transaction.
-         * @return A new instance of FreeTransactionManager}.
-         * @throw  IllegalArgumentException If one of the parameters is null.
-         * @since 2.0.0
-         */
-        virtual std::shared_ptr<FreeTransactionManager> createFreeTransactionManager(
-            const std::shared_ptr<CardReader> cardReader, const std::shared_ptr<CalypsoCard> card)
+        = 0;
+
+    /**
+     * Returns a new instance of FreeTransactionManager.
+     *
+     * @param cardReader The card reader to be used.
+     * @param card The selected card on which to operate the transaction.
+     * @return A new instance of FreeTransactionManager.
+     * @throw IllegalArgumentException If one of the parameters is null.
+     * @since 2.0.0
+     */
+    virtual std::shared_ptr<FreeTransactionManager> createFreeTransactionManager(
+        const std::shared_ptr<CardReader> cardReader, const std::shared_ptr<CalypsoCard> card)
         = 0;
 
     /**
@@ -100,6 +141,62 @@ public:
         const std::shared_ptr<SymmetricCryptoSecuritySetting> securitySetting)
         = 0;
 
+    /**
+     * Returns a new transaction plan capturing the commands currently prepared on the provided
+     * FreeTransactionManager.
+     *
+     * <p>The prepared commands of the provided manager are left unchanged and may still be
+     * processed.
+     *
+     * @param transactionManager The reference transaction manager holding the prepared commands.
+     * @return A new instance of TransactionPlan.
+     * @throw IllegalArgumentException If the manager is null or holds no prepared command.
+     * @see TransactionPlan
+     * @since 2.0.0
+     */
+    virtual std::shared_ptr<TransactionPlan<FreeTransactionManager>>
+    createTransactionPlan(const std::shared_ptr<FreeTransactionManager> transactionManager) = 0;
+
+    /**
+     * Returns a new transaction plan capturing the commands currently prepared on the provided
+     * SecureRegularModeTransactionManager.
+     *
+     * <p>The prepared commands of the provided manager are left unchanged and may still be
+     * processed. The security setting of the provided manager is shared by the managers produced
+     * by the plan.
+     *
+     * @param transactionManager The reference transaction manager holding the prepared commands.
+     * @return A new instance of TransactionPlan.
+     * @throw IllegalArgumentException If the manager is null or holds no prepared command.
+     * @throw IllegalStateException If a secure session is currently open on the provided manager.
+     * @see TransactionPlan
+     * @since 2.0.0
+     */
+    virtual std::shared_ptr<TransactionPlan<SecureRegularModeTransactionManager>>
+    createTransactionPlan(
+        const std::shared_ptr<SecureRegularModeTransactionManager> transactionManager)
+        = 0;
+
+    /**
+     * Returns a new transaction plan capturing the commands currently prepared on the provided
+     * SecureExtendedModeTransactionManager.
+     *
+     * <p>The prepared commands of the provided manager are left unchanged and may still be
+     * processed. The security setting of the provided manager is shared by the managers produced
+     * by the plan.
+     *
+     * @param transactionManager The reference transaction manager holding the prepared commands.
+     * @return A new instance of TransactionPlan.
+     * @throw IllegalArgumentException If the manager is null or holds no prepared command.
+     * @throw IllegalStateException If a secure session is currently open on the provided manager.
+     * @see TransactionPlan
+     * @since 2.0.0
+     */
+    virtual std::shared_ptr<TransactionPlan<SecureExtendedModeTransactionManager>>
+    createTransactionPlan(
+        const std::shared_ptr<SecureExtendedModeTransactionManager> transactionManager)
+        = 0;
+
     /**
      * Returns a new instance of SearchCommandData}.
      *
@@ -0,0 +1,134 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <stdexcept>
+
+namespace keypop {
+namespace calypso {
+namespace card {
+
+/**
+ * Value that may be absent, stored inline (value + presence flag) without any allocation.
+ *
+ * <p>This is a minimal C++11 equivalent of {@code java.util.Optional}, intended for scalar values
+ * (the type must be default constructible and copyable).
+ *
+ * <p>The card image getters offer at most one allocation-free form beside the original {@code
+ * std::shared_ptr} form: an {@code Optional} for scalar values and a non-owning pointer (the
+ * "Ptr" getters) for objects.
+ *
+ * @param <T> The type of the value.
+ * @since 2.0.0
+ */
+template <typename T>
+class Optional final {
+public:
+    /**
+     * Creates an empty instance.
+     *
+     * @since 2.0.0
+     */
+    Optional() : mValue(), mPresent(false) {}
+
+    /**
+     * Creates an instance holding the provided value.
+     *
+     * @param value The value.
+     * @since 2.0.0
+     */
+    Optional(const T& value) : mValue(value), mPresent(true) {}
+
+    /**
+     * Returns an empty instance.
+     *
+     * @return An empty instance.
+     * @since 2.0.0
+     */
+    static Optional
+    empty() {
+        return Optional();
+    }
+
+    /**
+     * Returns an instance holding the provided value.
+     *
+     * @param value The value.
+     * @return A not empty instance.
+     * @since 2.0.0
+     */
+    static Optional
+    of(const T& value) {
+        return Optional(value);
+    }
+
+    /**
+     * Indicates whether a value is present.
+     *
+     * @return True if a value is present.
+     * @since 2.0.0
+     */
+    bool
+    isPresent() const {
+        return mPresent;
+    }
+
+    /**
+     * Gets the value.
+     *
+     * @return The value.
+     * @throw std::logic_error If no value is present.
+     * @since 2.0.0
+     */
+    const T&
+    get() const {
+        if (!mPresent) {
+            throw std::logic_error("No value present");
+        }
+
+        return mValue;
+    }
+
+    /**
+     * Gets the value if present, otherwise the provided one.
+     *
+     * @param other The value to return if no value is present.
+     * @return The value or other.
+     * @since 2.0.0
+     */
+    T
+    orElse(const T& other) const {
+        return mPresent ? mValue : other;
+    }
+
+    /**
+     * Indicates whether a value is present.
+     *
+     * @since 2.0.0
+     */
+    explicit operator bool() const {
+        return mPresent;
+    }
+
+private:
+    /**
+     *
+     */
+    T mValue;
+
+    /**
+     *
+     */
+    bool mPresent;
+};
+
+} /* namespace card */
+} /* namespace calypso */
+} /* namespace keypop */
@@ -9,12 +9,22 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <map>
 #include <memory>
 #include <ostream>
+#include <utility>
 #include <vector>
 
+#include "keypop/calypso/card/card/CardChange.hpp"
+#include "keypop/calypso/card/card/CardImage.hpp"
+#include "keypop/calypso/card/card/DirectoryHeader.hpp"
+#include "keypop/calypso/card/card/ElementaryFile.hpp"
+#include "keypop/calypso/card/card/SvDebitLogEntry.hpp"
+#include "keypop/calypso/card/card/SvDebitLogRecord.hpp"
+#include "keypop/calypso/card/card/SvLoadLogEntry.hpp"
+#include "keypop/calypso/card/card/SvLoadLogRecord.hpp"
 #include "keypop/reader/selection/spi/IsoSmartCard.hpp"
 
 namespace keypop {
@@ -22,6 +32,8 @@ namespace calypso {
 namespace card {
 namespace card {
 
+using keypop::reader::selection::spi::IsoSmartCard;
+
 /**
  * Extends the {@link IsoSmartCard} interface of the "Keypop Reader API" to provide additional
  * functionality specific to Calypso cards.
@@ -45,10 +57,40 @@ namespace card {
  *       by the card transaction manager.
  * </ul>
  *
+ * <p>Non-owning accessors: the getters of the card image whose name ends with "Ptr" return a raw
+ * pointer instead of a {@code std::shared_ptr}, so that no reference counting is involved. Such a
+ * pointer does not share the ownership of the object: it remains valid as long as the {@code
+ * CalypsoCard} exists and until the next processing of commands by a transaction manager
+ * operating on it.
+ *
  * @since 1.0.0
  */
 class CalypsoCard : public IsoSmartCard {
 public:
+    /**
+     * Number of entries of the SFI index (SFIs are coded on 5 bits).
+     *
+     * @since 2.0.0
+     */
+    static const int SFI_INDEX_SIZE = 32;
+
+    /**
+     * Table of Elementary Files indexed by SFI.
+     *
+     * <p>The entry at index {@code sfi} references the EF having this SFI, or is null if no such EF
+     * is known. Entry 0 is always null (SFI 0 designates the current EF).
+     *
+     * @since 2.0.0
+     */
+    using SfiIndex = std::array<std::shared_ptr<ElementaryFile>, SFI_INDEX_SIZE>;
+
+    /**
+     * Table of (LID, Elementary File) entries sorted by ascending LID, suitable for binary search.
+     *
+     * @since 2.0.0
+     */
+    using LidIndex = std::vector<std::pair<uint16_t, std::shared_ptr<ElementaryFile>>>;
+
     /**
      * All Calypso Card products supported by this API.
      *
@@ -251,30 +293,101 @@ public:
      */
     virtual const std::shared_ptr<DirectoryHeader> getDirectoryHeader() const = 0;
 
+    /**
+     * Returns a non-owning pointer to the metadata of the current DF.
+     *
+     * <p>See the lifetime of non-owning accessors in {@link CalypsoCard}.
+     *
+     * @return Null if is not set.
+     * @see #getDirectoryHeader()
+     * @since 2.0.0
+     */
+    virtual const DirectoryHeader* getDirectoryHeaderPtr() const = 0;
+
     /**
      * Returns a reference to the ElementaryFile that has the provided SFI.
      *
      * <p>Note that if a secure session is actually running, then the object contains all session
      * modifications, which can be canceled if the secure session fails.
      *
+     * <p>The lookup is a direct access to the SFI index (see {@link #getSfiIndex()}) and does not
+     * allocate.
+     *
      * @param sfi The SFI to search.
      * @return Null if the requested EF is not found or if the SFI is equal to 0.
      * @since 1.0.0
      */
     virtual const std::shared_ptr<ElementaryFile> getFileBySfi(const uint8_t sfi) const = 0;
 
+    /**
+     * Returns a non-owning pointer to the ElementaryFile that has the provided SFI.
+     *
+     * <p>See the lifetime of non-owning accessors in {@link CalypsoCard}.
+     *
+     * @param sfi The SFI to search.
+     * @return Null if the requested EF is not found or if the SFI is equal to 0.
+     * @see #getFileBySfi(byte)
+     * @since 2.0.0
+     */
+    virtual const ElementaryFile* getFileBySfiPtr(const uint8_t sfi) const = 0;
+
     /**
      * Returns a reference to the ElementaryFile that has the provided LID value.
      *
      * <p>Note that if a secure session is actually running, then the object contains all session
      * modifications, which can be canceled if the secure session fails.
      *
+     * <p>The lookup is a binary search in the LID index (see {@link #getLidIndex()}) and does not
+     * allocate.
+     *
      * @param lid The LID to search.
      * @return Null if the requested EF is not found.
      * @since 1.0.0
      */
     virtual const std::shared_ptr<ElementaryFile> getFileByLid(const uint16_t lid) const = 0;
 
+    /**
+     * Returns a non-owning pointer to the ElementaryFile that has the provided LID value.
+     *
+     * <p>See the lifetime of non-owning accessors in {@link CalypsoCard}.
+     *
+     * @param lid The LID to search.
+     * @return Null if the requested EF is not found.
+     * @see #getFileByLid(short)
+     * @since 2.0.0
+     */
+    virtual const ElementaryFile* getFileByLidPtr(const uint16_t lid) const = 0;
+
+    /**
+     * Returns a reference to the table of all known Elementary Files indexed by their SFI.
+     *
+     * <p>The table is maintained by the card image as files are added and is not rebuilt on each
+     * call, making it the preferred way to iterate over the files having an SFI.
+     *
+     * <p>Note that if a secure session is actually running, then the table contains all session
+     * modifications, which can be canceled if the secure session fails.
+     *
+     * @return A not null reference, valid as long as the card object exists.
+     * @since 2.0.0
+     */
+    virtual const SfiIndex& getSfiIndex() const = 0;
+
+    /**
+     * Returns a reference to the table of all known Elementary Files having a known LID, sorted by
+     * ascending LID.
+     *
+     * <p>The table is maintained by the card image as file headers are set and is not rebuilt on
+     * each call.
+     *
+     * <p>Note that if a secure session is actually running, then the table contains all session
+     * modifications, which can be canceled if the secure session fails.
+     *
+     * @return A not null reference (it may be empty if no EF header is known), valid as long as the
+     *         card object exists.
+     * @since 2.0.0
+     */
+    virtual const LidIndex& getLidIndex() const = 0;
+
     /**
      * Returns a reference to a map of all known Elementary Files by their associated SFI.
      *
@@ -284,6 +397,8 @@ public:
      * @return A not null reference (it may be empty if no one EF is set).
      * @since 1.0.0
      * @deprecated Since an EF may not have an SFI, the getFiles() method must be used instead.
+     *             The map is built on each call; use getSfiIndex() for an allocation-free access
+     *             by SFI.
      */
     virtual const std::map<const uint8_t, const std::shared_ptr<ElementaryFile>> getAllFiles() const
         = 0;
@@ -299,6 +414,59 @@ public:
      */
     virtual const std::vector<std::shared_ptr<ElementaryFile>>& getFiles() const = 0;
 
+    /**
+     * Returns the contents of all the known Elementary Files and SV logs, stored in a single
+     * contiguous arena.
+     *
+     * <p>Unlike {@link #getFiles()}, the records are not stored in separate heap blocks: the image
+     * can be copied, serialized or released as a whole, and the records of a file can be walked
+     * through consecutive index entries.
+     *
+     * <p>Note that if a secure session is actually running, then the image contains all session
+     * modifications, which can be canceled if the secure session fails.
+     *
+     * @return A not null reference (it may be empty if no content is known), valid as long as the
+     *         card object exists.
+     * @since 2.0.0
+     */
+    virtual const CardImage& getCardImage() const = 0;
+
+    /**
+     * Appends a binary snapshot of the card to the provided buffer.
+     *
+     * <p>The snapshot is the serialized form of a {@link CardSnapshot} (see
+     * {@link CardSnapshot#serialize(std::vector&)}): the identification and startup data, the
+     * card flags, the DF and EF headers, the session data (transaction counter, PIN and SV
+     * status) and the serialized {@link CardImage} holding the record, counter and binary contents
+     * and the SV logs. Restoring it does not parse the record contents.
+     *
+     * <p>The snapshot can be stored or memory-mapped and then restored with
+     * {@link CalypsoCardApiFactory#restoreCalypsoCard(ByteArrayView)}.
+     *
+     * @param snapshot The buffer to append to.
+     * @since 2.0.0
+     */
+    virtual void exportSnapshot(std::vector<uint8_t>& snapshot) const = 0;
+
+    /**
+     * Returns the journal of the areas of the card image updated by the last processing of the
+     * transaction manager, in the order of the updates.
+     *
+     * <p>The journal is cleared at the beginning of each processing and lists an entry for each
+     * record or binary byte range and each counter whose content has been updated, whether the
+     * data was read from the card or modified by a prepared command. It allows the application to
+     * process the changes without scanning all the files with {@link #getFiles()}.
+     *
+     * <p>Note that the journal does not tell whether the new content differs from the previous
+     * one. If a secure session is actually running, the entries describe session modifications,
+     * which can be canceled if the secure session fails.
+     *
+     * @return A not null reference (it may be empty if nothing was updated), valid until the next
+     *         processing.
+     * @since 2.0.0
+     */
+    virtual const std::vector<CardChange>& getChanges() const = 0;
+
     /**
      * Tells if the last session with this card has been ratified or not.
      *
@@ -470,6 +638,32 @@ public:
      */
     virtual const std::vector<std::shared_ptr<SvDebitLogRecord>> getSvDebitLogAllRecords() const
         = 0;
+
+    /**
+     * Gets the last SV load log, decoded once when it is read from the card.
+     *
+     * <p>Same as {@link #getSvLoadLogRecord()} but no object is allocated.
+     *
+     * @return Null if not available. The pointer is valid until the next processing of the
+     *         transaction manager.
+     * @see #getSvLoadLogRecord()
+     * @since 2.0.0
+     */
+    virtual const SvLoadLogEntry* getSvLoadLogEntry() const = 0;
+
+    /**
+     * Gets the SV debit logs read from the card, most recent first, decoded once into a contiguous
+     * array when they are read from the card.
+     *
+     * <p>Same as {@link #getSvDebitLogAllRecords()} but neither the list nor the records are
+     * allocated on each call.
+     *
+     * @return A not null reference (empty if no log records are available), valid as long as the
+     *         card object exists.
+     * @see #getSvDebitLogAllRecords()
+     * @since 2.0.0
+     */
+    virtual const std::vector<SvDebitLogEntry>& getSvDebitLogEntries() const = 0;
 };
 
 inline std::ostream&
@@ -10,9 +10,12 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 
+#include "keypop/calypso/card/GetDataTag.hpp"
 #include "keypop/calypso/card/SelectFileControl.hpp"
 #include "keypop/calypso/card/WriteAccessLevel.hpp"
+#include "keypop/calypso/card/card/ReadAheadProfile.hpp"
 #include "keypop/reader/selection/spi/CardSelectionExtension.hpp"
 
 namespace keypop {
@@ -216,9 +219,13 @@ public:
      *       previously read outside the session)
      *   <li>the session is opened with an access level different from the pre-opening one
      *   <li>an intermediate "processCommand(...)" call has been made
-     *   <li>the session uses asymmetric cryptography
+     *   <li>the session uses asymmetric cryptography (see {@link
+     *       #preparePreOpenSecureSessionInPkiMode()})
      * </ul>
      *
+     * <p>Whether the pre-opening data has actually been used can be checked after the session
+     * opening with {@link SecureTransactionManager#isPreOpenSecureSessionDataUsed()}.
+     *
      * @param writeAccessLevel The write access level.
      * @return The current instance.
      * @throw IllegalArgumentException If writeAccessLevel is null.
@@ -252,7 +259,7 @@ public:
      *
      * <pre>{@code
      * transaction
-     *   .preparePreOpenSecureSessionInPkiMode(...)
+     *   .prepareOpenSecureSession()
      *   .prepare...
      *   [...]
      *   .prepare...
@@ -268,12 +275,50 @@ public:
      *   <li>the session uses symmetric cryptography
      * </ul>
      *
+     * <p>Whether the pre-opening data has actually been used can be checked after the session
+     * opening with {@link SecureTransactionManager#isPreOpenSecureSessionDataUsed()}.
+     *
      * @return The current instance.
-     * @throw IllegalArgumentException If writeAccessLevel is null.
      * @throw IllegalStateException If "Pre-Open" command is already prepared.
+     * @see #preparePreOpenSecureSession(WriteAccessLevel)
      * @since 2.0.0
      */
-    // CalypsoCardSelectionExtension preparePreOpenSecureSessionInPkiMode();
+    virtual CalypsoCardSelectionExtension& preparePreOpenSecureSessionInPkiMode() = 0;
+
+    /**
+     * Registers the reads to be performed speculatively during the selection of cards having the
+     * provided application type and software version.
+     *
+     * <p>The selection request is built before the card is known: the reads of all registered
+     * profiles are therefore merged (identical reads are sent once) and appended to the selection
+     * request, after the commands prepared with the other "prepare" methods. They are executed in
+     * best-effort mode: a read rejected by the card (e.g. file not found) is silently ignored and
+     * does not make the selection fail.
+     *
+     * <p>Once the selection is done, the data read is stored in {@link CalypsoCard} only for the
+     * reads of the profile matching the {@link CalypsoCard#getApplicationType()} and {@link
+     * CalypsoCard#getSoftwareVersion()} values of the selected card; the other responses are
+     * discarded since the same SFI may designate files of different structures in other layouts.
+     *
+     * <p>This is an optimization only: the application must not rely on the presence of the data
+     * and should check the {@link CalypsoCard} content before preparing its own reads. Registering
+     * many profiles with disjoint reads lengthens the selection exchange for every card.
+     *
+     * @param applicationType The application type of the targeted cards.
+     * @param softwareVersion The software version of the targeted cards.
+     * @param profile The reads to perform.
+     * @return The current instance.
+     * @throw IllegalArgumentException If the profile is null or invalid.
+     * @throw IllegalStateException If a profile is already registered for the same application
+     *        type and software version.
+     * @see CalypsoCardApiFactory#createReadAheadProfile()
+     * @since 2.0.0
+     */
+    virtual CalypsoCardSelectionExtension& addReadAheadProfile(
+        const uint8_t applicationType,
+        const uint8_t softwareVersion,
+        const std::shared_ptr<ReadAheadProfile> profile)
+        = 0;
 };
 
 } /* namespace card */
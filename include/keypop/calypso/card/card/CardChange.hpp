@@ -0,0 +1,233 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "keypop/calypso/card/card/FileKey.hpp"
+
+namespace keypop {
+namespace calypso {
+namespace card {
+namespace card {
+
+/**
+ * Entry of the change journal of a {@link CalypsoCard} image, describing an area of an Elementary
+ * File whose content has been updated.
+ *
+ * <p>An entry identifies either a byte range of a record, a byte range of a binary file, or a
+ * counter. The file is designated by its {@link FileKey}, in the same key space as in the
+ * {@link CardImage}. Instances are small immutable values.
+ *
+ * @see CalypsoCard#getChanges()
+ * @since 2.0.0
+ */
+class CardChange final {
+public:
+    /**
+     * Kind of updated area.
+     *
+     * @since 2.0.0
+     */
+    enum class Type {
+        /**
+         * A byte range of a record.
+         *
+         * @since 2.0.0
+         */
+        RECORD,
+
+        /**
+         * A byte range of a binary file.
+         *
+         * @since 2.0.0
+         */
+        BINARY,
+
+        /**
+         * A counter of a Counters or Simulated Counter EF.
+         *
+         * @since 2.0.0
+         */
+        COUNTER
+    };
+
+    /**
+     * Creates an entry describing a byte range of a record.
+     *
+     * @param file The key of the file.
+     * @param recordNumber The record number.
+     * @param offset The offset of the first updated byte in the record.
+     * @param length The number of updated bytes.
+     * @return A new instance.
+     * @since 2.0.0
+     */
+    static CardChange
+    ofRecord(
+        const FileKey file,
+        const int recordNumber,
+        const size_t offset,
+        const size_t length) {
+        return CardChange(Type::RECORD, file, recordNumber, offset, length);
+    }
+
+    /**
+     * Creates an entry describing a byte range of a binary file.
+     *
+     * @param file The key of the file.
+     * @param offset The offset of the first updated byte in the file.
+     * @param length The number of updated bytes.
+     * @return A new instance.
+     * @since 2.0.0
+     */
+    static CardChange
+    ofBinary(const FileKey file, const size_t offset, const size_t length) {
+        return CardChange(Type::BINARY, file, 1, offset, length);
+    }
+
+    /**
+     * Creates an entry describing a counter.
+     *
+     * @param file The key of the file.
+     * @param counterNumber The counter number.
+     * @return A new instance.
+     * @since 2.0.0
+     */
+    static CardChange
+    ofCounter(const FileKey file, const int counterNumber) {
+        return CardChange(
+            Type::COUNTER, file, counterNumber, static_cast<size_t>(3 * (counterNumber - 1)), 3);
+    }
+
+    /**
+     * Gets the kind of updated area.
+     *
+     * @return The type.
+     * @since 2.0.0
+     */
+    Type
+    getType() const {
+        return mType;
+    }
+
+    /**
+     * Gets the key of the updated file.
+     *
+     * @return The file key.
+     * @since 2.0.0
+     */
+    FileKey
+    getFile() const {
+        return mFile;
+    }
+
+    /**
+     * Gets the updated record number (1 for a binary file) or counter number.
+     *
+     * @return A value greater or equal to 1.
+     * @since 2.0.0
+     */
+    int
+    getNumber() const {
+        return mNumber;
+    }
+
+    /**
+     * Gets the offset of the first updated byte in the record or in the binary file.
+     *
+     * <p>For a counter, this is the offset of the counter in record #1.
+     *
+     * @return A positive or zero value.
+     * @since 2.0.0
+     */
+    size_t
+    getOffset() const {
+        return mOffset;
+    }
+
+    /**
+     * Gets the number of updated bytes (3 for a counter).
+     *
+     * @return A positive value.
+     * @since 2.0.0
+     */
+    size_t
+    getLength() const {
+        return mLength;
+    }
+
+    /**
+     * Compares two entries.
+     *
+     * @param o The other entry.
+     * @return True if both entries describe the same area.
+     * @since 2.0.0
+     */
+    bool
+    operator==(const CardChange& o) const {
+        return mType == o.mType && mFile == o.mFile && mNumber == o.mNumber && mOffset == o.mOffset
+               && mLength == o.mLength;
+    }
+
+    /**
+     * Compares two entries.
+     *
+     * @param o The other entry.
+     * @return True if the entries describe different areas.
+     * @since 2.0.0
+     */
+    bool
+    operator!=(const CardChange& o) const {
+        return !(*this == o);
+    }
+
+private:
+    /**
+     *
+     */
+    CardChange(
+        const Type type,
+        const FileKey file,
+        const int number,
+        const size_t offset,
+        const size_t length)
+    : mType(type), mFile(file), mNumber(number), mOffset(offset), mLength(length) {}
+
+    /**
+     *
+     */
+    Type mType;
+
+    /**
+     *
+     */
+    FileKey mFile;
+
+    /**
+     *
+     */
+    int mNumber;
+
+    /**
+     *
+     */
+    size_t mOffset;
+
+    /**
+     *
+     */
+    size_t mLength;
+};
+
+} /* namespace card */
+} /* namespace card */
+} /* namespace calypso */
+} /* namespace keypop */
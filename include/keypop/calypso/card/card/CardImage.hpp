@@ -0,0 +1,904 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "keypop/calypso/card/ArrayView.hpp"
+#include "keypop/calypso/card/card/FileKey.hpp"
+
+namespace keypop {
+namespace calypso {
+namespace card {
+namespace card {
+
+/**
+ * Content of a Calypso card image (records, counters, binary files and SV logs) stored in a single
+ * contiguous arena.
+ *
+ * <p>The bytes of all the records are stored in one buffer and located through a flat index
+ * sorted by file key and record number. Files are designated by a {@link FileKey}, so that EFs
+ * designated by their SFI, EFs without SFI (designated by their LID) and SV logs use separate key
+ * spaces. Counters are stored in record #1 of their EF and binary files in record #1 of their EF
+ * as well. The SV load log is stored in record #1 of {@link FileKey#svLoadLog()} and the SV debit
+ * logs from record #1 of {@link FileKey#svDebitLog()}, most recent first.
+ *
+ * <p>Copying an image copies two contiguous buffers, discarding it releases them, and walking the
+ * records of a file reads consecutive index entries.
+ *
+ * <p>When a record grows beyond its allocated capacity, it is moved to the end of the arena and
+ * its previous area is left unused until {@link #compact()} or {@link #clear()} is called.
+ *
+ * <p>The image keeps track of the bytes actually known. A record written from an offset beyond
+ * its current length is padded with zeros, and the padding is recorded as an unknown range until
+ * it is written; the bytes beyond the length of a record are unknown unless the whole record
+ * content has been set. {@link #isKnown(FileKey, uint8_t, size_t, size_t)} and {@link
+ * #isComplete(FileKey, uint8_t)} tell whether a read would return data not yet in the image.
+ *
+ * <p>An image can be serialized into a compact binary form (all integers are big-endian):
+ * <ul>
+ *   <li>Header (13 bytes): format version (1 byte, {@link #FORMAT_VERSION}), number of records (4
+ *       bytes), number of unknown ranges (4 bytes), arena size (4 bytes).
+ *   <li>Index: one 11-byte entry per record, sorted by file key and record number: key space (1
+ *       byte, {@link FileKey::Space}), key identifier (2 bytes), record number (1 byte), flags (1
+ *       byte, {@link #FLAG_COMPLETE}), content length (2 bytes), content offset in the arena (4
+ *       bytes).
+ *   <li>Unknown ranges: one 8-byte entry per range, sorted by file key, record number and
+ *       offset: key space (1 byte), key identifier (2 bytes), record number (1 byte), offset in
+ *       the record (2 bytes), length (2 bytes).
+ *   <li>Arena: the contents of the records, without unused areas.
+ * </ul>
+ * Restoring an image copies the arena in one block and decodes the fixed-size index entries; the
+ * record contents are not parsed.
+ *
+ * @since 2.0.0
+ */
+class CardImage final {
+public:
+    /**
+     * Index entry locating the content of a record in the arena.
+     *
+     * @since 2.0.0
+     */
+    struct Record {
+        /**
+         * Offset of the first byte of the record in the arena.
+         *
+         * @since 2.0.0
+         */
+        uint32_t offset;
+
+        /**
+         * Length of the content of the record, including its unknown ranges.
+         *
+         * @since 2.0.0
+         */
+        uint16_t length;
+
+        /**
+         * Number of bytes allocated for the record in the arena.
+         *
+         * @since 2.0.0
+         */
+        uint16_t capacity;
+
+        /**
+         * Key of the file.
+         *
+         * @since 2.0.0
+         */
+        FileKey file;
+
+        /**
+         * Record number.
+         *
+         * @since 2.0.0
+         */
+        uint8_t number;
+
+        /**
+         * True if the whole content of the record is known.
+         *
+         * @since 2.0.0
+         */
+        bool complete;
+    };
+
+    /**
+     * Range of bytes of a record whose content is unknown (zero padding).
+     *
+     * @since 2.0.0
+     */
+    struct Gap {
+        /**
+         * Key of the file.
+         *
+         * @since 2.0.0
+         */
+        FileKey file;
+
+        /**
+         * Record number.
+         *
+         * @since 2.0.0
+         */
+        uint8_t number;
+
+        /**
+         * Offset of the first unknown byte in the record.
+         *
+         * @since 2.0.0
+         */
+        uint16_t offset;
+
+        /**
+         * Number of unknown bytes.
+         *
+         * @since 2.0.0
+         */
+        uint16_t length;
+    };
+
+    /**
+     * Maximum length of a record content.
+     *
+     * @since 2.0.0
+     */
+    static const size_t MAX_RECORD_LENGTH = 0xFFFF;
+
+    /**
+     * Version of the serialized format.
+     *
+     * @since 2.0.0
+     */
+    static const uint8_t FORMAT_VERSION = 1;
+
+    /**
+     * Size of the header of the serialized form.
+     *
+     * @since 2.0.0
+     */
+    static const size_t SERIALIZED_HEADER_SIZE = 13;
+
+    /**
+     * Size of an index entry in the serialized form.
+     *
+     * @since 2.0.0
+     */
+    static const size_t SERIALIZED_RECORD_SIZE = 11;
+
+    /**
+     * Size of an unknown range entry in the serialized form.
+     *
+     * @since 2.0.0
+     */
+    static const size_t SERIALIZED_GAP_SIZE = 8;
+
+    /**
+     * Flag of a serialized index entry set when the whole content of the record is known.
+     *
+     * @since 2.0.0
+     */
+    static const uint8_t FLAG_COMPLETE = 0x01;
+
+    /**
+     * Creates an empty image.
+     *
+     * @since 2.0.0
+     */
+    CardImage() : mArena(), mRecords(), mGaps() {}
+
+    /**
+     * Pre-allocates the storage to avoid further allocations while the image is filled.
+     *
+     * @param arenaSize The expected total size of the contents.
+     * @param recordsCount The expected number of records.
+     * @since 2.0.0
+     */
+    void
+    reserve(const size_t arenaSize, const size_t recordsCount) {
+        mArena.reserve(arenaSize);
+        mRecords.reserve(recordsCount);
+    }
+
+    /**
+     * Removes all the records, keeping the allocated storage.
+     *
+     * @since 2.0.0
+     */
+    void
+    clear() {
+        mArena.clear();
+        mRecords.clear();
+        mGaps.clear();
+    }
+
+    /**
+     * Replaces the content of a record, creating the record if needed.
+     *
+     * <p>The whole content of the record is then known.
+     *
+     * @param file The key of the file.
+     * @param numRecord The record number.
+     * @param content The new content (must not point into this image).
+     * @throw std::invalid_argument If the content is longer than {@link #MAX_RECORD_LENGTH}.
+     * @since 2.0.0
+     */
+    void
+    setContent(const FileKey file, const uint8_t numRecord, const ByteArrayView content) {
+        Record& record = allocate(file, numRecord, content.size(), false);
+        record.length = static_cast<uint16_t>(content.size());
+        record.complete = true;
+        std::copy(content.begin(), content.end(), mArena.begin() + record.offset);
+        removeGaps(file, numRecord, 0, MAX_RECORD_LENGTH);
+    }
+
+    /**
+     * Writes bytes into a record from the provided offset, creating the record if needed.
+     *
+     * <p>The bytes outside the written range are kept and the written bytes become known. If the
+     * offset is beyond the current content length, the gap is filled with zeros and recorded as
+     * unknown. A record growing this way is no longer complete.
+     *
+     * @param file The key of the file.
+     * @param numRecord The record number.
+     * @param content The bytes to write (must not point into this image).
+     * @param offset The offset of the first byte to write in the record.
+     * @throw std::invalid_argument If the resulting content is longer than
+     *        {@link #MAX_RECORD_LENGTH}.
+     * @since 2.0.0
+     */
+    void
+    setContent(
+        const FileKey file,
+        const uint8_t numRecord,
+        const ByteArrayView content,
+        const size_t offset) {
+        const size_t end = offset + content.size();
+        Record& record = allocate(file, numRecord, end, true);
+        const size_t length = record.length;
+        grow(record, end);
+        std::copy(content.begin(), content.end(), mArena.begin() + record.offset + offset);
+        if (offset > length) {
+            addGap(file, numRecord, length, offset);
+        }
+        removeGaps(file, numRecord, offset, end);
+    }
+
+    /**
+     * Performs a binary OR between the bytes of a record from the provided offset and the provided
+     * bytes, creating the record if needed.
+     *
+     * <p>The unknown bytes remain unknown, as well as the bytes added beyond the current content
+     * length (zero-padded before the OR). A record growing this way is no longer complete.
+     *
+     * @param file The key of the file.
+     * @param numRecord The record number.
+     * @param content The bytes to OR (must not point into this image).
+     * @param offset The offset of the first byte to OR in the record.
+     * @throw std::invalid_argument If the resulting content is longer than
+     *        {@link #MAX_RECORD_LENGTH}.
+     * @since 2.0.0
+     */
+    void
+    fillContent(
+        const FileKey file,
+        const uint8_t numRecord,
+        const ByteArrayView content,
+        const size_t offset) {
+        const size_t end = offset + content.size();
+        Record& record = allocate(file, numRecord, end, true);
+        const size_t length = record.length;
+        grow(record, end);
+        for (size_t i = 0; i < content.size(); i++) {
+            mArena[record.offset + offset + i] |= content[i];
+        }
+        if (end > length) {
+            addGap(file, numRecord, length, end);
+        }
+    }
+
+    /**
+     * Shifts the records of a cyclic file and sets the new record #1.
+     *
+     * <p>Each record of the file is renumbered with the next number, the record having the highest
+     * number being discarded, along with the knowledge of their unknown ranges.
+     *
+     * @param file The key of the file.
+     * @param content The content of the new record #1 (must not point into this image).
+     * @throw std::invalid_argument If the content is longer than {@link #MAX_RECORD_LENGTH}.
+     * @since 2.0.0
+     */
+    void
+    addCyclicContent(const FileKey file, const ByteArrayView content) {
+        const auto first = lowerBound(file, 0);
+        auto last = first;
+        while (last != mRecords.end() && last->file == file) {
+            ++last;
+        }
+
+        if (first != last) {
+            const size_t index = static_cast<size_t>(first - mRecords.begin());
+            removeContent(file, (last - 1)->number);
+            for (size_t i = index; i < mRecords.size() && mRecords[i].file == file; i++) {
+                mRecords[i].number++;
+            }
+            for (Gap& gap : mGaps) {
+                if (gap.file == file) {
+                    gap.number++;
+                }
+            }
+        }
+
+        setContent(file, 1, content);
+    }
+
+    /**
+     * Removes a record.
+     *
+     * @param file The key of the file.
+     * @param numRecord The record number.
+     * @since 2.0.0
+     */
+    void
+    removeContent(const FileKey file, const uint8_t numRecord) {
+        const auto it = lowerBound(file, numRecord);
+        if (it != mRecords.end() && it->file == file && it->number == numRecord) {
+            mRecords.erase(it);
+            removeGaps(file, numRecord, 0, MAX_RECORD_LENGTH);
+        }
+    }
+
+    /**
+     * Indicates whether a range of bytes of a record is known.
+     *
+     * @param file The key of the file.
+     * @param numRecord The record number.
+     * @param offset The offset of the first byte of the range.
+     * @param length The number of bytes of the range.
+     * @return True if the record is set, holds the range, and no byte of the range is unknown.
+     * @since 2.0.0
+     */
+    bool
+    isKnown(
+        const FileKey file,
+        const uint8_t numRecord,
+        const size_t offset,
+        const size_t length) const {
+        const auto it = lowerBound(file, numRecord);
+        if (it == mRecords.end() || it->file != file || it->number != numRecord
+            || offset + length > it->length) {
+            return false;
+        }
+
+        for (auto gap = lowerBoundGap(file, numRecord, 0);
+             gap != mGaps.end() && gap->file == file && gap->number == numRecord;
+             ++gap) {
+            if (gap->offset < offset + length
+                && offset < static_cast<size_t>(gap->offset) + gap->length) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * Indicates whether the whole content of a record is known, i.e. it has been set as a whole
+     * and has not grown since.
+     *
+     * @param file The key of the file.
+     * @param numRecord The record number.
+     * @return True if the record is set and complete.
+     * @since 2.0.0
+     */
+    bool
+    isComplete(const FileKey file, const uint8_t numRecord) const {
+        const auto it = lowerBound(file, numRecord);
+        return it != mRecords.end() && it->file == file && it->number == numRecord
+               && it->complete;
+    }
+
+    /**
+     * Gets a view of the content of a record, the unknown ranges being filled with zeros.
+     *
+     * <p>The view is invalidated by the next modification of the image.
+     *
+     * @param file The key of the file.
+     * @param numRecord The record number.
+     * @return An empty view if the record is not set.
+     * @since 2.0.0
+     */
+    ByteArrayView
+    getContent(const FileKey file, const uint8_t numRecord) const {
+        const auto it = lowerBound(file, numRecord);
+        if (it == mRecords.end() || it->file != file || it->number != numRecord) {
+            return ByteArrayView(nullptr, 0);
+        }
+
+        return getContent(*it);
+    }
+
+    /**
+     * Gets a view of the content of a record located by its index entry.
+     *
+     * @param record An index entry of this image.
+     * @return A view of the record content.
+     * @since 2.0.0
+     */
+    ByteArrayView
+    getContent(const Record& record) const {
+        return ByteArrayView(mArena.data() + record.offset, record.length);
+    }
+
+    /**
+     * Gets the index entries of all the records, sorted by file key and record number.
+     *
+     * @return A view invalidated by the next modification of the image.
+     * @since 2.0.0
+     */
+    ArrayView<Record>
+    getRecords() const {
+        return mRecords;
+    }
+
+    /**
+     * Gets the index entries of the records of a file, sorted by record number.
+     *
+     * @param file The key of the file.
+     * @return An empty view if no record of the file is set, invalidated by the next modification
+     *         of the image.
+     * @since 2.0.0
+     */
+    ArrayView<Record>
+    getRecords(const FileKey file) const {
+        const auto first = lowerBound(file, 0);
+        auto last = first;
+        while (last != mRecords.end() && last->file == file) {
+            ++last;
+        }
+
+        return ArrayView<Record>(
+            mRecords.data() + (first - mRecords.begin()), static_cast<size_t>(last - first));
+    }
+
+    /**
+     * Gets the unknown ranges of all the records, sorted by file key, record number and offset.
+     *
+     * @return A view invalidated by the next modification of the image.
+     * @since 2.0.0
+     */
+    ArrayView<Gap>
+    getGaps() const {
+        return mGaps;
+    }
+
+    /**
+     * Gets a view of the whole arena, including the unused areas left by moved records.
+     *
+     * @return A view invalidated by the next modification of the image.
+     * @since 2.0.0
+     */
+    ByteArrayView
+    getArena() const {
+        return mArena;
+    }
+
+    /**
+     * Rebuilds the arena without the unused areas, the records being stored in index order.
+     *
+     * @since 2.0.0
+     */
+    void
+    compact() {
+        std::vector<uint8_t> arena;
+        size_t size = 0;
+        for (const Record& record : mRecords) {
+            size += record.length;
+        }
+        arena.reserve(size);
+
+        for (Record& record : mRecords) {
+            const uint32_t offset = static_cast<uint32_t>(arena.size());
+            arena.insert(
+                arena.end(),
+                mArena.begin() + record.offset,
+                mArena.begin() + record.offset + record.length);
+            record.offset = offset;
+            record.capacity = record.length;
+        }
+
+        mArena.swap(arena);
+    }
+
+    /**
+     * Appends the serialized form of the image to the provided buffer.
+     *
+     * @param out The buffer to append to.
+     * @since 2.0.0
+     */
+    void
+    serialize(std::vector<uint8_t>& out) const {
+        size_t arenaSize = 0;
+        for (const Record& record : mRecords) {
+            arenaSize += record.length;
+        }
+        out.reserve(
+            out.size() + SERIALIZED_HEADER_SIZE + SERIALIZED_RECORD_SIZE * mRecords.size()
+            + SERIALIZED_GAP_SIZE * mGaps.size() + arenaSize);
+
+        out.push_back(static_cast<uint8_t>(FORMAT_VERSION));
+        appendInt(out, mRecords.size(), 4);
+        appendInt(out, mGaps.size(), 4);
+        appendInt(out, arenaSize, 4);
+
+        size_t offset = 0;
+        for (const Record& record : mRecords) {
+            appendKey(out, record.file, record.number);
+            out.push_back(record.complete ? FLAG_COMPLETE : 0);
+            appendInt(out, record.length, 2);
+            appendInt(out, offset, 4);
+            offset += record.length;
+        }
+
+        for (const Gap& gap : mGaps) {
+            appendKey(out, gap.file, gap.number);
+            appendInt(out, gap.offset, 2);
+            appendInt(out, gap.length, 2);
+        }
+
+        for (const Record& record : mRecords) {
+            out.insert(
+                out.end(),
+                mArena.begin() + record.offset,
+                mArena.begin() + record.offset + record.length);
+        }
+    }
+
+    /**
+     * Replaces the content of the image with the one of a serialized image, reusing the allocated
+     * storage.
+     *
+     * @param data The serialized image, possibly followed by other data.
+     * @return The number of bytes of the serialized image.
+     * @throw std::invalid_argument If the data is truncated, malformed (e.g. records sharing bytes
+     *        of the arena), or has an unsupported format version. The image is then empty.
+     * @since 2.0.0
+     */
+    size_t
+    deserialize(const ByteArrayView data) {
+        clear();
+
+        if (data.size() < SERIALIZED_HEADER_SIZE || data[0] != FORMAT_VERSION) {
+            throw std::invalid_argument("Unsupported or truncated card image");
+        }
+
+        const size_t recordsCount = static_cast<size_t>(readInt(data.data() + 1, 4));
+        const size_t gapsCount = static_cast<size_t>(readInt(data.data() + 5, 4));
+        const size_t arenaSize = static_cast<size_t>(readInt(data.data() + 9, 4));
+        size_t available = data.size() - SERIALIZED_HEADER_SIZE;
+        if (recordsCount > available / SERIALIZED_RECORD_SIZE) {
+            throw std::invalid_argument("Truncated card image");
+        }
+        available -= SERIALIZED_RECORD_SIZE * recordsCount;
+        if (gapsCount > available / SERIALIZED_GAP_SIZE) {
+            throw std::invalid_argument("Truncated card image");
+        }
+        available -= SERIALIZED_GAP_SIZE * gapsCount;
+        if (available < arenaSize) {
+            throw std::invalid_argument("Truncated card image");
+        }
+        const size_t arenaOffset = data.size() - available;
+
+        try {
+            mRecords.reserve(recordsCount);
+            const uint8_t* entry = data.data() + SERIALIZED_HEADER_SIZE;
+            for (size_t i = 0; i < recordsCount; i++, entry += SERIALIZED_RECORD_SIZE) {
+                const uint16_t length = static_cast<uint16_t>(readInt(entry + 5, 2));
+                const uint32_t offset = readInt(entry + 7, 4);
+                mRecords.push_back(Record{
+                    offset, length, length, readKey(entry), entry[3], entry[4] == FLAG_COMPLETE});
+                if ((entry[4] & ~FLAG_COMPLETE) != 0
+                    || static_cast<size_t>(offset) + length > arenaSize
+                    || (i > 0
+                        && !isBefore(mRecords[i - 1], mRecords[i].file, mRecords[i].number))) {
+                    throw std::invalid_argument("Malformed card image");
+                }
+            }
+            checkNoOverlap();
+
+            mGaps.reserve(gapsCount);
+            for (size_t i = 0; i < gapsCount; i++, entry += SERIALIZED_GAP_SIZE) {
+                const Gap gap = {
+                    readKey(entry),
+                    entry[3],
+                    static_cast<uint16_t>(readInt(entry + 4, 2)),
+                    static_cast<uint16_t>(readInt(entry + 6, 2))};
+                const auto record = lowerBound(gap.file, gap.number);
+                if (gap.length == 0 || record == mRecords.end() || record->file != gap.file
+                    || record->number != gap.number || record->complete
+                    || static_cast<size_t>(gap.offset) + gap.length > record->length
+                    || (i > 0 && !isBefore(mGaps[i - 1], gap))) {
+                    throw std::invalid_argument("Malformed card image");
+                }
+                mGaps.push_back(gap);
+            }
+        } catch (const std::invalid_argument&) {
+            clear();
+            throw std::invalid_argument("Malformed card image");
+        }
+
+        mArena.assign(data.begin() + arenaOffset, data.begin() + arenaOffset + arenaSize);
+
+        return arenaOffset + arenaSize;
+    }
+
+private:
+    /**
+     * Rejects records sharing bytes of the arena, which a write through one of them would
+     * silently alter in the other.
+     */
+    void
+    checkNoOverlap() const {
+        std::vector<std::pair<uint32_t, uint32_t>> ranges;
+        ranges.reserve(mRecords.size());
+        for (const Record& record : mRecords) {
+            if (record.length > 0) {
+                ranges.push_back({record.offset, record.offset + record.length});
+            }
+        }
+
+        std::sort(ranges.begin(), ranges.end());
+        for (size_t i = 1; i < ranges.size(); i++) {
+            if (ranges[i].first < ranges[i - 1].second) {
+                throw std::invalid_argument("Malformed card image");
+            }
+        }
+    }
+
+    /**
+     *
+     */
+    std::vector<Record>::const_iterator
+    lowerBound(const FileKey file, const uint8_t numRecord) const {
+        return std::lower_bound(
+            mRecords.begin(),
+            mRecords.end(),
+            Record{0, 0, 0, file, numRecord, false},
+            [](const Record& record, const Record& value) {
+                return isBefore(record, value.file, value.number);
+            });
+    }
+
+    /**
+     *
+     */
+    std::vector<Gap>::iterator
+    lowerBoundGap(const FileKey file, const uint8_t numRecord, const size_t offset) {
+        return std::lower_bound(
+            mGaps.begin(),
+            mGaps.end(),
+            Gap{file, numRecord, static_cast<uint16_t>(offset), 0},
+            [](const Gap& gap, const Gap& value) { return isBefore(gap, value); });
+    }
+
+    /**
+     *
+     */
+    std::vector<Gap>::const_iterator
+    lowerBoundGap(const FileKey file, const uint8_t numRecord, const size_t offset) const {
+        return std::lower_bound(
+            mGaps.begin(),
+            mGaps.end(),
+            Gap{file, numRecord, static_cast<uint16_t>(offset), 0},
+            [](const Gap& gap, const Gap& value) { return isBefore(gap, value); });
+    }
+
+    /**
+     *
+     */
+    static bool
+    isBefore(const Record& record, const FileKey file, const uint8_t numRecord) {
+        return record.file != file ? record.file < file : record.number < numRecord;
+    }
+
+    /**
+     * Indicates whether a gap is ordered before another one, without overlapping it when both
+     * belong to the same record.
+     */
+    static bool
+    isBefore(const Gap& gap, const Gap& other) {
+        if (gap.file != other.file) {
+            return gap.file < other.file;
+        }
+        if (gap.number != other.number) {
+            return gap.number < other.number;
+        }
+
+        return static_cast<size_t>(gap.offset) + gap.length <= other.offset;
+    }
+
+    /**
+     * Extends the content of a record with zeros up to the provided end, the record being no
+     * longer complete.
+     */
+    void
+    grow(Record& record, const size_t end) {
+        if (end > record.length) {
+            std::fill(
+                mArena.begin() + record.offset + record.length,
+                mArena.begin() + record.offset + end,
+                static_cast<uint8_t>(0));
+            record.length = static_cast<uint16_t>(end);
+            record.complete = false;
+        }
+    }
+
+    /**
+     * Records the range [from, to) of a record as unknown. The range must be located after all the
+     * unknown ranges of the record.
+     */
+    void
+    addGap(const FileKey file, const uint8_t numRecord, const size_t from, const size_t to) {
+        auto it = lowerBoundGap(file, numRecord, MAX_RECORD_LENGTH);
+        if (it != mGaps.begin()) {
+            Gap& previous = *(it - 1);
+            if (previous.file == file && previous.number == numRecord
+                && static_cast<size_t>(previous.offset) + previous.length == from) {
+                previous.length = static_cast<uint16_t>(to - previous.offset);
+                return;
+            }
+        }
+
+        mGaps.insert(
+            it,
+            Gap{file,
+                numRecord,
+                static_cast<uint16_t>(from),
+                static_cast<uint16_t>(to - from)});
+    }
+
+    /**
+     * Records the range [from, to) of a record as known.
+     */
+    void
+    removeGaps(const FileKey file, const uint8_t numRecord, const size_t from, const size_t to) {
+        auto it = lowerBoundGap(file, numRecord, 0);
+        while (it != mGaps.end() && it->file == file && it->number == numRecord) {
+            const size_t begin = it->offset;
+            const size_t end = begin + it->length;
+            if (end <= from || begin >= to) {
+                ++it;
+            } else if (begin < from && end > to) {
+                it->length = static_cast<uint16_t>(from - begin);
+                mGaps.insert(
+                    it + 1,
+                    Gap{file,
+                        numRecord,
+                        static_cast<uint16_t>(to),
+                        static_cast<uint16_t>(end - to)});
+                return;
+            } else if (begin < from) {
+                it->length = static_cast<uint16_t>(from - begin);
+                ++it;
+            } else if (end > to) {
+                it->offset = static_cast<uint16_t>(to);
+                it->length = static_cast<uint16_t>(end - to);
+                ++it;
+            } else {
+                it = mGaps.erase(it);
+            }
+        }
+    }
+
+    /**
+     *
+     */
+    static void
+    appendKey(std::vector<uint8_t>& out, const FileKey file, const uint8_t numRecord) {
+        out.push_back(static_cast<uint8_t>(file.getSpace()));
+        appendInt(out, file.getId(), 2);
+        out.push_back(numRecord);
+    }
+
+    /**
+     *
+     */
+    static FileKey
+    readKey(const uint8_t* in) {
+        return FileKey::of(in[0], static_cast<uint16_t>(readInt(in + 1, 2)));
+    }
+
+    /**
+     *
+     */
+    static void
+    appendInt(std::vector<uint8_t>& out, const size_t value, const size_t size) {
+        for (size_t i = size; i > 0; i--) {
+            out.push_back(static_cast<uint8_t>(value >> (8 * (i - 1))));
+        }
+    }
+
+    /**
+     *
+     */
+    static uint32_t
+    readInt(const uint8_t* in, const size_t size) {
+        uint32_t value = 0;
+        for (size_t i = 0; i < size; i++) {
+            value = (value << 8) | in[i];
+        }
+
+        return value;
+    }
+
+    /**
+     * Gets the record, creating it or moving it to the end of the arena if it cannot hold the
+     * provided length.
+     */
+    Record&
+    allocate(const FileKey file, const uint8_t numRecord, const size_t length, const bool keep) {
+        if (length > MAX_RECORD_LENGTH) {
+            throw std::invalid_argument("Record content too long");
+        }
+
+        const auto it = lowerBound(file, numRecord);
+        const size_t index = static_cast<size_t>(it - mRecords.begin());
+        if (it == mRecords.end() || it->file != file || it->number != numRecord) {
+            const uint32_t offset = static_cast<uint32_t>(mArena.size());
+            mArena.resize(mArena.size() + length);
+            mRecords.insert(
+                mRecords.begin() + index,
+                Record{offset, 0, static_cast<uint16_t>(length), file, numRecord, false});
+            return mRecords[index];
+        }
+
+        Record& record = mRecords[index];
+        if (length > record.capacity) {
+            const size_t offset = mArena.size();
+            mArena.resize(offset + length);
+            if (keep) {
+                std::copy(
+                    mArena.begin() + record.offset,
+                    mArena.begin() + record.offset + record.length,
+                    mArena.begin() + offset);
+            }
+            record.offset = static_cast<uint32_t>(offset);
+            record.capacity = static_cast<uint16_t>(length);
+        }
+
+        return record;
+    }
+
+    /**
+     *
+     */
+    std::vector<uint8_t> mArena;
+
+    /**
+     *
+     */
+    std::vector<Record> mRecords;
+
+    /**
+     *
+     */
+    std::vector<Gap> mGaps;
+};
+
+} /* namespace card */
+} /* namespace card */
+} /* namespace calypso */
+} /* namespace keypop */
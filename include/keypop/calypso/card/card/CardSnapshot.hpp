@@ -0,0 +1,685 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "keypop/calypso/card/ArrayView.hpp"
+#include "keypop/calypso/card/card/CardImage.hpp"
+#include "keypop/calypso/card/card/ElementaryFile.hpp"
+
+namespace keypop {
+namespace calypso {
+namespace card {
+namespace card {
+
+/**
+ * All the data needed to rebuild a {@link CalypsoCard}, as exported by {@link
+ * CalypsoCard#exportSnapshot(std::vector&)} and restored by {@link
+ * CalypsoCardApiFactory#restoreCalypsoCard(ByteArrayView)}.
+ *
+ * <p>The serialized form is fully specified, so that a snapshot produced by an implementation can
+ * be restored by another one. All integers are big-endian; a "byte string" is a 2-byte length
+ * followed by the bytes.
+ * <ul>
+ *   <li>Format version (1 byte, {@link #FORMAT_VERSION}).
+ *   <li>Identification: power-on data (byte string holding the characters), select application
+ *       response (byte string), product type (1 byte, rank of the value in the declaration of
+ *       {@link CalypsoCard::ProductType}), DF name (byte string), application serial number
+ *       (byte string), startup information (byte string), traceability information (byte
+ *       string).
+ *   <li>Card flags (1 byte): see {@link #FLAG_HCE} to {@link #FLAG_SV_FEATURE}.
+ *   <li>Directory header: presence (1 byte, 0 or 1) then, if present, LID (2 bytes), DF status (1
+ *       byte), access conditions (byte string), key indexes (byte string), KIF and KVC for each
+ *       {@link WriteAccessLevel} in declaration order (6 bytes).
+ *   <li>EF headers: number of headers (2 bytes) then, for each header, SFI (1 byte, 0 for an EF
+ *       without SFI), LID (2 bytes), EF type (1 byte, rank in the declaration of {@link
+ *       ElementaryFile::Type}), number of records (2 bytes), record size (2 bytes), access
+ *       conditions (byte string), key indexes (byte string), presence flags (1 byte: {@link
+ *       #HEADER_DF_STATUS}, {@link #HEADER_SHARED_REFERENCE}), DF status (1 byte) and shared
+ *       reference (2 bytes), both 0 when absent.
+ *   <li>Session data: presence flags (1 byte: {@link #SESSION_TRANSACTION_COUNTER}, {@link
+ *       #SESSION_PIN_ATTEMPTS}, {@link #SESSION_SV_DATA}), transaction counter (3 bytes), PIN
+ *       attempts remaining (1 byte), SV balance (3 bytes, signed), SV last transaction number (2
+ *       bytes), each being 0 when absent.
+ *   <li>Card image: the serialized {@link CardImage}, holding the records, counters, binary
+ *       contents and SV logs.
+ * </ul>
+ *
+ * @since 2.0.0
+ */
+struct CardSnapshot {
+    /**
+     * Header of the current DF.
+     *
+     * @since 2.0.0
+     */
+    struct DfHeader {
+        /**
+         * LID.
+         *
+         * @since 2.0.0
+         */
+        uint16_t lid;
+
+        /**
+         * DF status.
+         *
+         * @since 2.0.0
+         */
+        uint8_t dfStatus;
+
+        /**
+         * Access conditions.
+         *
+         * @since 2.0.0
+         */
+        std::vector<uint8_t> accessConditions;
+
+        /**
+         * Key indexes.
+         *
+         * @since 2.0.0
+         */
+        std::vector<uint8_t> keyIndexes;
+
+        /**
+         * KIF for each {@link WriteAccessLevel}, in declaration order.
+         *
+         * @since 2.0.0
+         */
+        std::array<uint8_t, 3> kifs;
+
+        /**
+         * KVC for each {@link WriteAccessLevel}, in declaration order.
+         *
+         * @since 2.0.0
+         */
+        std::array<uint8_t, 3> kvcs;
+    };
+
+    /**
+     * Header of an EF.
+     *
+     * @since 2.0.0
+     */
+    struct EfHeader {
+        /**
+         * SFI, 0 for an EF without SFI.
+         *
+         * @since 2.0.0
+         */
+        uint8_t sfi;
+
+        /**
+         * LID.
+         *
+         * @since 2.0.0
+         */
+        uint16_t lid;
+
+        /**
+         * EF type.
+         *
+         * @since 2.0.0
+         */
+        ElementaryFile::Type efType;
+
+        /**
+         * Number of records.
+         *
+         * @since 2.0.0
+         */
+        uint16_t recordsNumber;
+
+        /**
+         * Record size.
+         *
+         * @since 2.0.0
+         */
+        uint16_t recordSize;
+
+        /**
+         * Access conditions.
+         *
+         * @since 2.0.0
+         */
+        std::vector<uint8_t> accessConditions;
+
+        /**
+         * Key indexes.
+         *
+         * @since 2.0.0
+         */
+        std::vector<uint8_t> keyIndexes;
+
+        /**
+         * Presence flags of the optional fields ({@link #HEADER_DF_STATUS}, {@link
+         * #HEADER_SHARED_REFERENCE}).
+         *
+         * @since 2.0.0
+         */
+        uint8_t presence;
+
+        /**
+         * DF status, if {@link #HEADER_DF_STATUS} is set.
+         *
+         * @since 2.0.0
+         */
+        uint8_t dfStatus;
+
+        /**
+         * Shared reference, if {@link #HEADER_SHARED_REFERENCE} is set.
+         *
+         * @since 2.0.0
+         */
+        uint16_t sharedReference;
+    };
+
+    /**
+     * Version of the serialized format.
+     *
+     * @since 2.0.0
+     */
+    static const uint8_t FORMAT_VERSION = 1;
+
+    /**
+     * Card flag set when the card is an HCE.
+     *
+     * @since 2.0.0
+     */
+    static const uint8_t FLAG_HCE = 0x01;
+
+    /**
+     * Card flag set when the DF is invalidated.
+     *
+     * @since 2.0.0
+     */
+    static const uint8_t FLAG_DF_INVALIDATED = 0x02;
+
+    /**
+     * Card flag set when the last session was ratified.
+     *
+     * @since 2.0.0
+     */
+    static const uint8_t FLAG_DF_RATIFIED = 0x04;
+
+    /**
+     * Card flag set when the PKI mode is supported.
+     *
+     * @since 2.0.0
+     */
+    static const uint8_t FLAG_PKI_MODE = 0x08;
+
+    /**
+     * Card flag set when the extended mode is supported.
+     *
+     * @since 2.0.0
+     */
+    static const uint8_t FLAG_EXTENDED_MODE = 0x10;
+
+    /**
+     * Card flag set when the ratification on deselect is supported.
+     *
+     * @since 2.0.0
+     */
+    static const uint8_t FLAG_RATIFICATION_ON_DESELECT = 0x20;
+
+    /**
+     * Card flag set when the PIN feature is available.
+     *
+     * @since 2.0.0
+     */
+    static const uint8_t FLAG_PIN_FEATURE = 0x40;
+
+    /**
+     * Card flag set when the SV feature is available.
+     *
+     * @since 2.0.0
+     */
+    static const uint8_t FLAG_SV_FEATURE = 0x80;
+
+    /**
+     * EF header flag set when the DF status is present.
+     *
+     * @since 2.0.0
+     */
+    static const uint8_t HEADER_DF_STATUS = 0x01;
+
+    /**
+     * EF header flag set when the shared reference is present.
+     *
+     * @since 2.0.0
+     */
+    static const uint8_t HEADER_SHARED_REFERENCE = 0x02;
+
+    /**
+     * Session data flag set when the transaction counter is known.
+     *
+     * @since 2.0.0
+     */
+    static const uint8_t SESSION_TRANSACTION_COUNTER = 0x01;
+
+    /**
+     * Session data flag set when the number of remaining PIN attempts is known.
+     *
+     * @since 2.0.0
+     */
+    static const uint8_t SESSION_PIN_ATTEMPTS = 0x02;
+
+    /**
+     * Session data flag set when the SV balance and last transaction number are known.
+     *
+     * @since 2.0.0
+     */
+    static const uint8_t SESSION_SV_DATA = 0x04;
+
+    /**
+     * Power-on data.
+     *
+     * @since 2.0.0
+     */
+    std::string powerOnData;
+
+    /**
+     * Select application response.
+     *
+     * @since 2.0.0
+     */
+    std::vector<uint8_t> selectApplicationResponse;
+
+    /**
+     * Rank of the product type in the declaration of {@link CalypsoCard::ProductType}.
+     *
+     * @since 2.0.0
+     */
+    uint8_t productType;
+
+    /**
+     * DF name.
+     *
+     * @since 2.0.0
+     */
+    std::vector<uint8_t> dfName;
+
+    /**
+     * Application serial number.
+     *
+     * @since 2.0.0
+     */
+    std::vector<uint8_t> applicationSerialNumber;
+
+    /**
+     * Startup information.
+     *
+     * @since 2.0.0
+     */
+    std::vector<uint8_t> startupInfo;
+
+    /**
+     * Traceability information.
+     *
+     * @since 2.0.0
+     */
+    std::vector<uint8_t> traceabilityInformation;
+
+    /**
+     * Card flags ({@link #FLAG_HCE} to {@link #FLAG_SV_FEATURE}).
+     *
+     * @since 2.0.0
+     */
+    uint8_t flags;
+
+    /**
+     * True if {@link #dfHeader} is present.
+     *
+     * @since 2.0.0
+     */
+    bool hasDfHeader;
+
+    /**
+     * Header of the current DF, if {@link #hasDfHeader} is true.
+     *
+     * @since 2.0.0
+     */
+    DfHeader dfHeader;
+
+    /**
+     * Headers of the EFs.
+     *
+     * @since 2.0.0
+     */
+    std::vector<EfHeader> efHeaders;
+
+    /**
+     * Presence flags of the session data ({@link #SESSION_TRANSACTION_COUNTER}, {@link
+     * #SESSION_PIN_ATTEMPTS}, {@link #SESSION_SV_DATA}).
+     *
+     * @since 2.0.0
+     */
+    uint8_t sessionData;
+
+    /**
+     * Transaction counter.
+     *
+     * @since 2.0.0
+     */
+    int transactionCounter;
+
+    /**
+     * Number of remaining PIN attempts.
+     *
+     * @since 2.0.0
+     */
+    int pinAttemptRemaining;
+
+    /**
+     * SV balance.
+     *
+     * @since 2.0.0
+     */
+    int svBalance;
+
+    /**
+     * SV last transaction number.
+     *
+     * @since 2.0.0
+     */
+    int svLastTNum;
+
+    /**
+     * Records, counters, binary contents and SV logs.
+     *
+     * @since 2.0.0
+     */
+    CardImage cardImage;
+
+    /**
+     * Creates an empty snapshot.
+     *
+     * @since 2.0.0
+     */
+    CardSnapshot()
+    : productType(0)
+    , flags(0)
+    , hasDfHeader(false)
+    , dfHeader()
+    , sessionData(0)
+    , transactionCounter(0)
+    , pinAttemptRemaining(0)
+    , svBalance(0)
+    , svLastTNum(0) {
+    }
+
+    /**
+     * Appends the serialized form of the snapshot to the provided buffer.
+     *
+     * @param out The buffer to append to.
+     * @throw std::invalid_argument If a byte string is longer than 65535 bytes.
+     * @since 2.0.0
+     */
+    void
+    serialize(std::vector<uint8_t>& out) const {
+        out.push_back(static_cast<uint8_t>(FORMAT_VERSION));
+        appendString(
+            out,
+            ByteArrayView(
+                reinterpret_cast<const uint8_t*>(powerOnData.data()), powerOnData.size()));
+        appendString(out, selectApplicationResponse);
+        out.push_back(productType);
+        appendString(out, dfName);
+        appendString(out, applicationSerialNumber);
+        appendString(out, startupInfo);
+        appendString(out, traceabilityInformation);
+        out.push_back(flags);
+
+        out.push_back(hasDfHeader ? 1 : 0);
+        if (hasDfHeader) {
+            appendInt(out, dfHeader.lid, 2);
+            out.push_back(dfHeader.dfStatus);
+            appendString(out, dfHeader.accessConditions);
+            appendString(out, dfHeader.keyIndexes);
+            out.insert(out.end(), dfHeader.kifs.begin(), dfHeader.kifs.end());
+            out.insert(out.end(), dfHeader.kvcs.begin(), dfHeader.kvcs.end());
+        }
+
+        appendInt(out, checkLength(efHeaders.size()), 2);
+        for (const EfHeader& header : efHeaders) {
+            out.push_back(header.sfi);
+            appendInt(out, header.lid, 2);
+            out.push_back(static_cast<uint8_t>(header.efType));
+            appendInt(out, header.recordsNumber, 2);
+            appendInt(out, header.recordSize, 2);
+            appendString(out, header.accessConditions);
+            appendString(out, header.keyIndexes);
+            out.push_back(header.presence);
+            out.push_back((header.presence & HEADER_DF_STATUS) != 0 ? header.dfStatus : 0);
+            appendInt(
+                out,
+                (header.presence & HEADER_SHARED_REFERENCE) != 0 ? header.sharedReference : 0,
+                2);
+        }
+
+        out.push_back(sessionData);
+        appendInt(
+            out,
+            (sessionData & SESSION_TRANSACTION_COUNTER) != 0 ? transactionCounter : 0,
+            3);
+        out.push_back(
+            static_cast<uint8_t>(
+                (sessionData & SESSION_PIN_ATTEMPTS) != 0 ? pinAttemptRemaining : 0));
+        const bool svData = (sessionData & SESSION_SV_DATA) != 0;
+        appendInt(out, svData ? svBalance : 0, 3);
+        appendInt(out, svData ? svLastTNum : 0, 2);
+
+        cardImage.serialize(out);
+    }
+
+    /**
+     * Replaces the content of the snapshot with the one of a serialized snapshot.
+     *
+     * @param data The serialized snapshot, possibly followed by other data.
+     * @return The number of bytes of the serialized snapshot.
+     * @throw std::invalid_argument If the data is truncated, malformed, or has an unsupported
+     *        format version.
+     * @since 2.0.0
+     */
+    size_t
+    deserialize(const ByteArrayView data) {
+        Reader in(data);
+        if (in.readByte() != FORMAT_VERSION) {
+            throw std::invalid_argument("Unsupported snapshot format version");
+        }
+
+        const std::vector<uint8_t> powerOn = in.readString();
+        powerOnData.assign(powerOn.begin(), powerOn.end());
+        selectApplicationResponse = in.readString();
+        productType = in.readByte();
+        dfName = in.readString();
+        applicationSerialNumber = in.readString();
+        startupInfo = in.readString();
+        traceabilityInformation = in.readString();
+        flags = in.readByte();
+
+        const uint8_t dfHeaderPresence = in.readByte();
+        if (dfHeaderPresence > 1) {
+            throw std::invalid_argument("Malformed snapshot");
+        }
+        hasDfHeader = dfHeaderPresence == 1;
+        if (hasDfHeader) {
+            dfHeader.lid = static_cast<uint16_t>(in.readInt(2));
+            dfHeader.dfStatus = in.readByte();
+            dfHeader.accessConditions = in.readString();
+            dfHeader.keyIndexes = in.readString();
+            for (uint8_t& kif : dfHeader.kifs) {
+                kif = in.readByte();
+            }
+            for (uint8_t& kvc : dfHeader.kvcs) {
+                kvc = in.readByte();
+            }
+        }
+
+        const size_t headersCount = static_cast<size_t>(in.readInt(2));
+        efHeaders.clear();
+        efHeaders.reserve(headersCount);
+        for (size_t i = 0; i < headersCount; i++) {
+            EfHeader header;
+            header.sfi = in.readByte();
+            header.lid = static_cast<uint16_t>(in.readInt(2));
+            const uint8_t efType = in.readByte();
+            if (efType > static_cast<uint8_t>(ElementaryFile::Type::SIMULATED_COUNTERS)) {
+                throw std::invalid_argument("Malformed snapshot");
+            }
+            header.efType = static_cast<ElementaryFile::Type>(efType);
+            header.recordsNumber = static_cast<uint16_t>(in.readInt(2));
+            header.recordSize = static_cast<uint16_t>(in.readInt(2));
+            header.accessConditions = in.readString();
+            header.keyIndexes = in.readString();
+            header.presence = in.readByte();
+            header.dfStatus = in.readByte();
+            header.sharedReference = static_cast<uint16_t>(in.readInt(2));
+            efHeaders.push_back(header);
+        }
+
+        sessionData = in.readByte();
+        transactionCounter = static_cast<int>(in.readInt(3));
+        pinAttemptRemaining = in.readByte();
+        const int balance = static_cast<int>(in.readInt(3));
+        svBalance = (balance & 0x800000) != 0 ? balance - 0x1000000 : balance;
+        svLastTNum = static_cast<int>(in.readInt(2));
+
+        return in.getPosition() + cardImage.deserialize(in.getRemaining());
+    }
+
+private:
+    /**
+     * Bounds-checked reader of a serialized snapshot.
+     */
+    class Reader {
+    public:
+        /**
+         *
+         */
+        explicit Reader(const ByteArrayView data) : mData(data), mPosition(0) {}
+
+        /**
+         *
+         */
+        uint8_t
+        readByte() {
+            check(1);
+            return mData[mPosition++];
+        }
+
+        /**
+         *
+         */
+        uint32_t
+        readInt(const size_t size) {
+            check(size);
+            uint32_t value = 0;
+            for (size_t i = 0; i < size; i++) {
+                value = (value << 8) | mData[mPosition++];
+            }
+
+            return value;
+        }
+
+        /**
+         *
+         */
+        std::vector<uint8_t>
+        readString() {
+            const size_t length = static_cast<size_t>(readInt(2));
+            check(length);
+            mPosition += length;
+            return std::vector<uint8_t>(
+                mData.begin() + (mPosition - length), mData.begin() + mPosition);
+        }
+
+        /**
+         *
+         */
+        size_t
+        getPosition() const {
+            return mPosition;
+        }
+
+        /**
+         *
+         */
+        ByteArrayView
+        getRemaining() const {
+            return ByteArrayView(mData.data() + mPosition, mData.size() - mPosition);
+        }
+
+    private:
+        /**
+         *
+         */
+        void
+        check(const size_t size) const {
+            if (mData.size() - mPosition < size) {
+                throw std::invalid_argument("Truncated snapshot");
+            }
+        }
+
+        /**
+         *
+         */
+        ByteArrayView mData;
+
+        /**
+         *
+         */
+        size_t mPosition;
+    };
+
+    /**
+     *
+     */
+    static size_t
+    checkLength(const size_t length) {
+        if (length > 0xFFFF) {
+            throw std::invalid_argument("Snapshot field too long");
+        }
+
+        return length;
+    }
+
+    /**
+     *
+     */
+    static void
+    appendInt(std::vector<uint8_t>& out, const size_t value, const size_t size) {
+        for (size_t i = size; i > 0; i--) {
+            out.push_back(static_cast<uint8_t>(value >> (8 * (i - 1))));
+        }
+    }
+
+    /**
+     *
+     */
+    static void
+    appendString(std::vector<uint8_t>& out, const ByteArrayView value) {
+        appendInt(out, checkLength(value.size()), 2);
+        out.insert(out.end(), value.begin(), value.end());
+    }
+};
+
+} /* namespace card */
+} /* namespace card */
+} /* namespace calypso */
+} /* namespace keypop */
@@ -0,0 +1,221 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "keypop/calypso/card/Optional.hpp"
+
+namespace keypop {
+namespace calypso {
+namespace card {
+namespace card {
+
+/**
+ * Dense view of the counters of a Counters or Simulated Counter EF.
+ *
+ * <p>Values are stored in a fixed-size contiguous array where index {@code i} holds the value of
+ * counter #{@code i + 1}, together with a presence bitmap telling which counters are known. No
+ * allocation is involved.
+ *
+ * @since 2.0.0
+ */
+class CounterValues final {
+public:
+    /**
+     * Maximum number of counters in a record (a 250-byte record holds 83 3-byte counters).
+     *
+     * @since 2.0.0
+     */
+    static const int MAX_COUNTERS = 83;
+
+    /**
+     * Array of counter values, index {@code i} corresponding to counter #{@code i + 1}.
+     *
+     * @since 2.0.0
+     */
+    using Values = std::array<int32_t, MAX_COUNTERS>;
+
+    /**
+     * Presence bitmap, bit {@code i} corresponding to counter #{@code i + 1}.
+     *
+     * @since 2.0.0
+     */
+    using Presence = std::bitset<MAX_COUNTERS>;
+
+    /**
+     * Creates an instance with no known counter.
+     *
+     * @since 2.0.0
+     */
+    CounterValues() : mValues(), mPresence(), mTruncatedCounter(false) {}
+
+    /**
+     * Decodes consecutive 3-byte big-endian counters into 32-bit values in one pass.
+     *
+     * <p>The loop has no dependency between iterations and can be vectorized by the compiler.
+     *
+     * @param data The raw counter bytes (at least 3 x nbCounters bytes).
+     * @param nbCounters The number of counters to decode.
+     * @param values The output array (at least nbCounters elements).
+     * @since 2.0.0
+     */
+    static void
+    decode(const uint8_t* data, const size_t nbCounters, int32_t* values) {
+        for (size_t i = 0; i < nbCounters; i++) {
+            values[i] = (static_cast<int32_t>(data[3 * i]) << 16)
+                        | (static_cast<int32_t>(data[3 * i + 1]) << 8)
+                        | static_cast<int32_t>(data[3 * i + 2]);
+        }
+    }
+
+    /**
+     * Replaces all counters with the ones contained in the provided record content.
+     *
+     * <p>The number of decoded counters is the record length divided by 3, limited to {@link
+     * #MAX_COUNTERS}. A truncated last counter (record length not a multiple of 3) is not decoded,
+     * as FileData#getAllCountersValue() does, since its value cannot be known; it is reported by
+     * {@link #hasTruncatedCounter()} instead of raising an exception so that the complete
+     * counters remain usable.
+     *
+     * @param record The content of record #1.
+     * @param length The length of the record content.
+     * @since 2.0.0
+     */
+    void
+    setFromRecord(const uint8_t* record, const size_t length) {
+        size_t nbCounters = length / 3;
+        if (nbCounters > static_cast<size_t>(MAX_COUNTERS)) {
+            nbCounters = MAX_COUNTERS;
+        }
+
+        decode(record, nbCounters, mValues.data());
+
+        mPresence.reset();
+        for (size_t i = 0; i < nbCounters; i++) {
+            mPresence.set(i);
+        }
+
+        mTruncatedCounter = length % 3 != 0 && nbCounters < static_cast<size_t>(MAX_COUNTERS);
+    }
+
+    /**
+     * Sets the value of a counter.
+     *
+     * @param counterNumber The counter number in range [1..83].
+     * @param value The counter value.
+     * @throw std::out_of_range If the counter number is out of range.
+     * @since 2.0.0
+     */
+    void
+    setValue(const int counterNumber, const int32_t value) {
+        const size_t index = toIndex(counterNumber);
+        mValues[index] = value;
+        mPresence.set(index);
+    }
+
+    /**
+     * Gets the value of a counter.
+     *
+     * @param counterNumber The counter number in range [1..83].
+     * @return An empty optional if the counter is not known.
+     * @throw std::out_of_range If the counter number is out of range.
+     * @since 2.0.0
+     */
+    Optional<int>
+    getValue(const int counterNumber) const {
+        const size_t index = toIndex(counterNumber);
+        return mPresence.test(index) ? Optional<int>(mValues[index]) : Optional<int>();
+    }
+
+    /**
+     * Gets the number of known counters.
+     *
+     * @return A value in range [0..83].
+     * @since 2.0.0
+     */
+    size_t
+    getCount() const {
+        return mPresence.count();
+    }
+
+    /**
+     * Indicates whether the last record provided to {@link #setFromRecord(const uint8_t*,
+     * size_t)} ended with a truncated counter, which has been ignored.
+     *
+     * @return True if a truncated counter has been ignored.
+     * @since 2.0.0
+     */
+    bool
+    hasTruncatedCounter() const {
+        return mTruncatedCounter;
+    }
+
+    /**
+     * Gets a reference to the array of values.
+     *
+     * <p>The value of a counter whose presence bit is not set is meaningless.
+     *
+     * @return A not null reference.
+     * @since 2.0.0
+     */
+    const Values&
+    getValues() const {
+        return mValues;
+    }
+
+    /**
+     * Gets a reference to the presence bitmap.
+     *
+     * @return A not null reference.
+     * @since 2.0.0
+     */
+    const Presence&
+    getPresence() const {
+        return mPresence;
+    }
+
+private:
+    /**
+     *
+     */
+    static size_t
+    toIndex(const int counterNumber) {
+        if (counterNumber < 1 || counterNumber > MAX_COUNTERS) {
+            throw std::out_of_range("Counter number out of range [1..83]");
+        }
+
+        return static_cast<size_t>(counterNumber - 1);
+    }
+
+    /**
+     *
+     */
+    Values mValues;
+
+    /**
+     *
+     */
+    Presence mPresence;
+
+    /**
+     *
+     */
+    bool mTruncatedCounter;
+};
+
+} /* namespace card */
+} /* namespace card */
+} /* namespace calypso */
+} /* namespace keypop */
@@ -14,7 +14,7 @@
 #include <ostream>
 #include <vector>
 
-#include "keypop/calypso/caard/card/FileData.hpp"
+#include "keypop/calypso/card/card/FileData.hpp"
 
 namespace keypop {
 namespace calypso {
@@ -94,6 +94,17 @@ public:
      */
     virtual const std::shared_ptr<FileHeader> getHeader() const = 0;
 
+    /**
+     * Gets a non-owning pointer to the file header.
+     *
+     * <p>See the lifetime of non-owning accessors in {@link CalypsoCard}.
+     *
+     * @return Null if header is not yet set.
+     * @see #getHeader()
+     * @since 2.0.0
+     */
+    virtual const FileHeader* getHeaderPtr() const = 0;
+
     /**
      * Gets the file data.
      *
@@ -102,6 +113,17 @@ public:
      */
     virtual const std::shared_ptr<FileData> getData() const = 0;
 
+    /**
+     * Gets a non-owning pointer to the file data.
+     *
+     * <p>See the lifetime of non-owning accessors in {@link CalypsoCard}.
+     *
+     * @return A not null pointer.
+     * @see #getData()
+     * @since 2.0.0
+     */
+    virtual const FileData* getDataPtr() const = 0;
+
     /**
      *
      */
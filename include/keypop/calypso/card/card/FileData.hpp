@@ -14,6 +14,10 @@
 #include <memory>
 #include <vector>
 
+#include "keypop/calypso/card/ArrayView.hpp"
+#include "keypop/calypso/card/Optional.hpp"
+#include "keypop/calypso/card/card/CounterValues.hpp"
+
 namespace keypop {
 namespace calypso {
 namespace card {
@@ -61,6 +65,53 @@ public:
     getContent(const uint8_t numRecord, const uint8_t dataOffset, const uint8_t dataLength) const
         = 0;
 
+    /**
+     * Gets a read-only view of the known content of record #1.<br>
+     * For a Binary file, it means all the bytes of the file.
+     *
+     * <p>Same as {@link #getContent()} but the bytes are not copied. The view points into the card
+     * image and is invalidated by the next update of the record, i.e. by the next processing of the
+     * transaction manager.
+     *
+     * @return An empty view if the record #1 is not set.
+     * @since 2.0.0
+     */
+    virtual ByteArrayView getContentView() const = 0;
+
+    /**
+     * Gets a read-only view of the known content of a specific record.
+     *
+     * <p>Same as {@link #getContent(uint8_t)} but the bytes are not copied. The view points into
+     * the card image and is invalidated by the next update of the record, i.e. by the next
+     * processing of the transaction manager.
+     *
+     * @param numRecord The record number.
+     * @return An empty view if the requested record is not set.
+     * @since 2.0.0
+     */
+    virtual ByteArrayView getContentView(const uint8_t numRecord) const = 0;
+
+    /**
+     * Gets a read-only view of a known content subset of a specific record from dataOffset to
+     * dataLength.
+     *
+     * <p>Same as {@link #getContent(uint8_t, uint8_t, uint8_t)} but the bytes are not copied. The
+     * view points into the card image and is invalidated by the next update of the record, i.e. by
+     * the next processing of the transaction manager.
+     *
+     * @param numRecord The record number.
+     * @param dataOffset The offset index (should be {@code >=} 0).
+     * @param dataLength The data length (should be {@code >=} 1).
+     * @return A not empty view of the record subset content when the record is set, an empty view
+     *         when the record is not set.
+     * @throw IllegalArgumentException if dataLength {@code <} 1.
+     * @throw IndexOutOfBoundsException if (dataOffset + dataLength) {@code >} content length.
+     * @since 2.0.0
+     */
+    virtual ByteArrayView
+    getContentView(const uint8_t numRecord, const uint8_t dataOffset, const uint8_t dataLength)
+        const = 0;
+
     /**
      * Gets a reference to all known records content.
      *
@@ -84,6 +135,21 @@ public:
      */
     virtual const std::shared_ptr<int> getContentAsCounterValue(const int numCounter) const = 0;
 
+    /**
+     * Gets the known value of the counter #numCounter.
+     *
+     * <p>Same as {@link #getContentAsCounterValue(int)} but the value is returned inline, without
+     * any allocation.
+     *
+     * @param numCounter The counter number (should be {@code >=} 1).
+     * @return An empty optional if record #1 or numCounter is not set.
+     * @throw IllegalArgumentException if numCounter is {@code <} 1.
+     * @throw IndexOutOfBoundsException if numCounter has a truncated value (when size of record #1
+     *        modulo 3 != 0).
+     * @since 2.0.0
+     */
+    virtual Optional<int> getOptionalContentAsCounterValue(const int numCounter) const = 0;
+
     /**
      * Gets all known counters value.<br>
      * The counters values are extracted from record #1.<br>
@@ -94,6 +160,18 @@ public:
      * @since 1.0.0
      */
     virtual const std::map<const int, const int> getAllCountersValue() const = 0;
+
+    /**
+     * Gets a reference to a dense view of all known counters values.
+     *
+     * <p>The counters values are extracted from record #1 in a single pass when the record is
+     * updated, and stored in a contiguous array with a presence bitmap. Unlike {@link
+     * #getAllCountersValue()}, no container is built on each call.
+     *
+     * @return A not null reference, with no counter present if record #1 is not set.
+     * @since 2.0.0
+     */
+    virtual const CounterValues& getCounterValues() const = 0;
 };
 
 } /* namespace card */
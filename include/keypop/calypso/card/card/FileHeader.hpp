@@ -13,6 +13,7 @@
 #include <memory>
 #include <vector>
 
+#include "keypop/calypso/card/Optional.hpp"
 #include "keypop/calypso/card/card/ElementaryFile.hpp"
 
 namespace keypop {
@@ -44,6 +45,17 @@ public:
      */
     virtual const std::shared_ptr<uint8_t> getDfStatus() const = 0;
 
+    /**
+     * Gets the DF status, returned inline without any allocation.
+     *
+     * @return An empty optional if the status is not available (e.g. when the {@code FileHeader}
+     *         is created following the response to a "Get Data" command with the
+     *         GetDataTag::EF_LIST tag).
+     * @see #getDfStatus()
+     * @since 2.0.0
+     */
+    virtual Optional<uint8_t> getOptionalDfStatus() const = 0;
+
     /**
      * Gets the Elementary File type.
      *
@@ -109,6 +121,17 @@ public:
      * @since 1.0.0
      */
     virtual const std::shared_ptr<uint16_t> getSharedReference() const = 0;
+
+    /**
+     * Gets the unique identifier of the shared data, returned inline without any allocation.
+     *
+     * @return Zero if the file data is not shared or an empty optional if the information is not
+     *         available (e.g. when the {@code FileHeader} is created following the response to a
+     *         "Get Data" command with the GetDataTag::EF_LIST tag).
+     * @see #getSharedReference()
+     * @since 2.0.0
+     */
+    virtual Optional<uint16_t> getOptionalSharedReference() const = 0;
 };
 
 } /* namespace card */
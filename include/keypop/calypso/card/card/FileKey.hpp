@@ -0,0 +1,239 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace keypop {
+namespace calypso {
+namespace card {
+namespace card {
+
+/**
+ * Identifier of a file of the card image.
+ *
+ * <p>A key belongs to one of three separate spaces, so that the identifiers of the different
+ * spaces never collide:
+ * <ul>
+ *   <li>{@link Space#SFI}: an EF designated by its SFI [1..30].
+ *   <li>{@link Space#LID}: an EF without SFI, designated by its LID.
+ *   <li>{@link Space#SV_LOG}: the SV load log ({@link #SV_LOAD_LOG}) or the SV debit logs
+ *       ({@link #SV_DEBIT_LOG}), which are not EFs.
+ * </ul>
+ * Keys are ordered by space first, then by identifier.
+ *
+ * @since 2.0.0
+ */
+class FileKey final {
+public:
+    /**
+     * Space of a key.
+     *
+     * @since 2.0.0
+     */
+    enum class Space : uint8_t {
+        /**
+         * EF designated by its SFI.
+         *
+         * @since 2.0.0
+         */
+        SFI = 0,
+
+        /**
+         * EF without SFI, designated by its LID.
+         *
+         * @since 2.0.0
+         */
+        LID = 1,
+
+        /**
+         * SV log.
+         *
+         * @since 2.0.0
+         */
+        SV_LOG = 2
+    };
+
+    /**
+     * Identifier of the SV load log in the space {@link Space#SV_LOG}. The log is stored in record
+     * #1.
+     *
+     * @since 2.0.0
+     */
+    static const uint16_t SV_LOAD_LOG = 0;
+
+    /**
+     * Identifier of the SV debit logs in the space {@link Space#SV_LOG}. The logs are stored from
+     * record #1, most recent first.
+     *
+     * @since 2.0.0
+     */
+    static const uint16_t SV_DEBIT_LOG = 1;
+
+    /**
+     * Creates the key of an EF designated by its SFI.
+     *
+     * @param sfi The SFI [1..30].
+     * @return A new instance.
+     * @throw std::invalid_argument If the SFI is out of range.
+     * @since 2.0.0
+     */
+    static FileKey
+    ofSfi(const uint8_t sfi) {
+        if (sfi < 1 || sfi > 30) {
+            throw std::invalid_argument("sfi");
+        }
+
+        return FileKey(Space::SFI, sfi);
+    }
+
+    /**
+     * Creates the key of an EF without SFI, designated by its LID.
+     *
+     * @param lid The LID.
+     * @return A new instance.
+     * @since 2.0.0
+     */
+    static FileKey
+    ofLid(const uint16_t lid) {
+        return FileKey(Space::LID, lid);
+    }
+
+    /**
+     * Creates the key of the SV load log.
+     *
+     * @return A new instance.
+     * @since 2.0.0
+     */
+    static FileKey
+    svLoadLog() {
+        return FileKey(Space::SV_LOG, SV_LOAD_LOG);
+    }
+
+    /**
+     * Creates the key of the SV debit logs.
+     *
+     * @return A new instance.
+     * @since 2.0.0
+     */
+    static FileKey
+    svDebitLog() {
+        return FileKey(Space::SV_LOG, SV_DEBIT_LOG);
+    }
+
+    /**
+     * Creates a key from its space and identifier, as stored in a serialized form.
+     *
+     * @param space The space.
+     * @param id The identifier in the space.
+     * @return A new instance.
+     * @throw std::invalid_argument If the space or the identifier is out of range.
+     * @since 2.0.0
+     */
+    static FileKey
+    of(const uint8_t space, const uint16_t id) {
+        switch (static_cast<Space>(space)) {
+        case Space::SFI:
+            if (id > 0xFF) {
+                throw std::invalid_argument("sfi");
+            }
+            return ofSfi(static_cast<uint8_t>(id));
+        case Space::LID:
+            return ofLid(id);
+        case Space::SV_LOG:
+            if (id != SV_LOAD_LOG && id != SV_DEBIT_LOG) {
+                throw std::invalid_argument("SV log");
+            }
+            return FileKey(Space::SV_LOG, id);
+        default:
+            throw std::invalid_argument("space");
+        }
+    }
+
+    /**
+     * Gets the space of the key.
+     *
+     * @return The space.
+     * @since 2.0.0
+     */
+    Space
+    getSpace() const {
+        return mSpace;
+    }
+
+    /**
+     * Gets the identifier of the key in its space (SFI, LID or SV log identifier).
+     *
+     * @return The identifier.
+     * @since 2.0.0
+     */
+    uint16_t
+    getId() const {
+        return mId;
+    }
+
+    /**
+     * Compares two keys.
+     *
+     * @param o The other key.
+     * @return True if both keys designate the same file.
+     * @since 2.0.0
+     */
+    bool
+    operator==(const FileKey& o) const {
+        return mSpace == o.mSpace && mId == o.mId;
+    }
+
+    /**
+     * Compares two keys.
+     *
+     * @param o The other key.
+     * @return True if the keys designate different files.
+     * @since 2.0.0
+     */
+    bool
+    operator!=(const FileKey& o) const {
+        return !(*this == o);
+    }
+
+    /**
+     * Orders two keys by space, then by identifier.
+     *
+     * @param o The other key.
+     * @return True if this key is ordered before the other one.
+     * @since 2.0.0
+     */
+    bool
+    operator<(const FileKey& o) const {
+        return mSpace != o.mSpace ? mSpace < o.mSpace : mId < o.mId;
+    }
+
+private:
+    /**
+     *
+     */
+    FileKey(const Space space, const uint16_t id) : mSpace(space), mId(id) {}
+
+    /**
+     *
+     */
+    Space mSpace;
+
+    /**
+     *
+     */
+    uint16_t mId;
+};
+
+} /* namespace card */
+} /* namespace card */
+} /* namespace calypso */
+} /* namespace keypop */
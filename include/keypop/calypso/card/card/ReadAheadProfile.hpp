@@ -0,0 +1,86 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace keypop {
+namespace calypso {
+namespace card {
+namespace card {
+
+/**
+ * Description of the file reads an application expects to perform right after the selection of a
+ * card having a given layout.
+ *
+ * <p>A profile is registered in a {@link CalypsoCardSelectionExtension} for a given application
+ * type and software version (see {@link
+ * CalypsoCardSelectionExtension#addReadAheadProfile(uint8_t, uint8_t, std::shared_ptr)}). Its
+ * reads are then executed speculatively during the selection, so that the data is often already
+ * available in {@link CalypsoCard} before the first transaction exchange.
+ *
+ * <p>An instance of this interface can be obtained via the method {@link
+ * CalypsoCardApiFactory#createReadAheadProfile()}.
+ *
+ * <p>The parameters are checked against the ranges documented in {@link
+ * CalypsoCardSelectionExtension}.
+ *
+ * @since 2.0.0
+ */
+class ReadAheadProfile {
+public:
+    /**
+     * Virtual destructor
+     */
+    virtual ~ReadAheadProfile() = default;
+
+    /**
+     * Adds the read of a single record from the indicated "linear" or "cyclic" EF.
+     *
+     * @param sfi The SFI of the EF to read
+     * @param recordNumber The record number to read.
+     * @return The current instance.
+     * @throw IllegalArgumentException If one of the provided argument is out of range.
+     * @see CalypsoCardSelectionExtension#prepareReadRecord(uint8_t, int)
+     * @since 2.0.0
+     */
+    virtual ReadAheadProfile& prepareReadRecord(const uint8_t sfi, const int recordNumber) = 0;
+
+    /**
+     * Adds the read of all or part of the indicated "binary" EF.
+     *
+     * @param sfi The SFI of the EF.
+     * @param offset The offset (0 indicates the first byte).
+     * @param nbBytesToRead The number of bytes to read.
+     * @return The current instance.
+     * @throw IllegalArgumentException If one of the provided argument is out of range.
+     * @see CalypsoCardSelectionExtension#prepareReadBinary(uint8_t, int, int)
+     * @since 2.0.0
+     */
+    virtual ReadAheadProfile&
+    prepareReadBinary(const uint8_t sfi, const int offset, const int nbBytesToRead) = 0;
+
+    /**
+     * Adds the read of the first counters of the indicated counter EF.
+     *
+     * @param sfi The SFI of the EF.
+     * @param nbCountersToRead The number of counters to read.
+     * @return The current instance.
+     * @throw IllegalArgumentException If one of the provided argument is out of range.
+     * @see CalypsoCardSelectionExtension#prepareReadCounter(uint8_t, int)
+     * @since 2.0.0
+     */
+    virtual ReadAheadProfile& prepareReadCounter(const uint8_t sfi, const int nbCountersToRead) = 0;
+};
+
+} /* namespace card */
+} /* namespace card */
+} /* namespace calypso */
+} /* namespace keypop */
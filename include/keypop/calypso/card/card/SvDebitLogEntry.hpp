@@ -0,0 +1,131 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "keypop/calypso/card/ArrayView.hpp"
+
+namespace keypop {
+namespace calypso {
+namespace card {
+namespace card {
+
+/**
+ * Stored Value debit log, decoded once into plain fields.
+ *
+ * <p>Same content as {@link SvDebitLogRecord}, as a value type: no allocation is needed to access
+ * the fields, the fixed-size ones being stored in {@code std::array}.
+ *
+ * @see CalypsoCard#getSvDebitLogEntries()
+ * @since 2.0.0
+ */
+struct SvDebitLogEntry {
+    /**
+     * Size of the raw data of a debit log.
+     *
+     * @since 2.0.0
+     */
+    static const size_t RAW_DATA_SIZE = 19;
+
+    /**
+     * Debit date.
+     *
+     * @since 2.0.0
+     */
+    std::array<uint8_t, 2> debitDate;
+
+    /**
+     * Debit time.
+     *
+     * @since 2.0.0
+     */
+    std::array<uint8_t, 2> debitTime;
+
+    /**
+     * Debit amount.
+     *
+     * @since 2.0.0
+     */
+    int amount;
+
+    /**
+     * SV balance.
+     *
+     * @since 2.0.0
+     */
+    int balance;
+
+    /**
+     * KVC of the debit key.
+     *
+     * @since 2.0.0
+     */
+    uint8_t kvc;
+
+    /**
+     * SAM ID.
+     *
+     * @since 2.0.0
+     */
+    std::array<uint8_t, 4> samId;
+
+    /**
+     * SAM transaction number.
+     *
+     * @since 2.0.0
+     */
+    int samTNum;
+
+    /**
+     * SV transaction number.
+     *
+     * @since 2.0.0
+     */
+    int svTNum;
+
+    /**
+     * Decodes a debit log from its raw data, as returned by the "SV Get" command or by the
+     * reading of the SV debit log file.
+     *
+     * @param rawData The raw data (at least {@link #RAW_DATA_SIZE} bytes).
+     * @return A new instance.
+     * @throw std::invalid_argument If the raw data is too short.
+     * @since 2.0.0
+     */
+    static SvDebitLogEntry
+    decode(const ByteArrayView rawData) {
+        if (rawData.size() < RAW_DATA_SIZE) {
+            throw std::invalid_argument("SV debit log too short");
+        }
+
+        const uint8_t* in = rawData.data();
+        SvDebitLogEntry entry;
+        entry.amount = static_cast<int16_t>((in[0] << 8) | in[1]);
+        entry.debitDate = {{in[2], in[3]}};
+        entry.debitTime = {{in[4], in[5]}};
+        entry.kvc = in[6];
+        entry.samId = {{in[7], in[8], in[9], in[10]}};
+        entry.samTNum = (in[11] << 16) | (in[12] << 8) | in[13];
+        const int balance = (in[14] << 16) | (in[15] << 8) | in[16];
+        entry.balance = (balance & 0x800000) != 0 ? balance - 0x1000000 : balance;
+        entry.svTNum = (in[17] << 8) | in[18];
+
+        return entry;
+    }
+};
+
+} /* namespace card */
+} /* namespace card */
+} /* namespace calypso */
+} /* namespace keypop */
@@ -0,0 +1,147 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "keypop/calypso/card/ArrayView.hpp"
+
+namespace keypop {
+namespace calypso {
+namespace card {
+namespace card {
+
+/**
+ * Stored Value load log, decoded once into plain fields.
+ *
+ * <p>Same content as {@link SvLoadLogRecord}, as a value type: no allocation is needed to access
+ * the fields, the fixed-size ones being stored in {@code std::array}.
+ *
+ * @see CalypsoCard#getSvLoadLogEntry()
+ * @since 2.0.0
+ */
+struct SvLoadLogEntry {
+    /**
+     * Size of the raw data of a load log.
+     *
+     * @since 2.0.0
+     */
+    static const size_t RAW_DATA_SIZE = 22;
+
+    /**
+     * Load date.
+     *
+     * @since 2.0.0
+     */
+    std::array<uint8_t, 2> loadDate;
+
+    /**
+     * Load time.
+     *
+     * @since 2.0.0
+     */
+    std::array<uint8_t, 2> loadTime;
+
+    /**
+     * Load amount.
+     *
+     * @since 2.0.0
+     */
+    int amount;
+
+    /**
+     * SV balance.
+     *
+     * @since 2.0.0
+     */
+    int balance;
+
+    /**
+     * Free data.
+     *
+     * @since 2.0.0
+     */
+    std::array<uint8_t, 2> freeData;
+
+    /**
+     * KVC of the load key.
+     *
+     * @since 2.0.0
+     */
+    uint8_t kvc;
+
+    /**
+     * SAM ID.
+     *
+     * @since 2.0.0
+     */
+    std::array<uint8_t, 4> samId;
+
+    /**
+     * SAM transaction number.
+     *
+     * @since 2.0.0
+     */
+    int samTNum;
+
+    /**
+     * SV transaction number.
+     *
+     * @since 2.0.0
+     */
+    int svTNum;
+
+    /**
+     * Decodes a load log from its raw data, as returned by the "SV Get" command.
+     *
+     * @param rawData The raw data (at least {@link #RAW_DATA_SIZE} bytes).
+     * @return A new instance.
+     * @throw std::invalid_argument If the raw data is too short.
+     * @since 2.0.0
+     */
+    static SvLoadLogEntry
+    decode(const ByteArrayView rawData) {
+        if (rawData.size() < RAW_DATA_SIZE) {
+            throw std::invalid_argument("SV load log too short");
+        }
+
+        const uint8_t* in = rawData.data();
+        SvLoadLogEntry entry;
+        entry.loadDate = {{in[0], in[1]}};
+        entry.freeData = {{in[2], in[4]}};
+        entry.kvc = in[3];
+        entry.balance = toSignedInt(in + 5);
+        entry.amount = toSignedInt(in + 8);
+        entry.loadTime = {{in[11], in[12]}};
+        entry.samId = {{in[13], in[14], in[15], in[16]}};
+        entry.samTNum = (in[17] << 16) | (in[18] << 8) | in[19];
+        entry.svTNum = (in[20] << 8) | in[21];
+
+        return entry;
+    }
+
+private:
+    /**
+     *
+     */
+    static int
+    toSignedInt(const uint8_t* in) {
+        const int value = (in[0] << 16) | (in[1] << 8) | in[2];
+        return (value & 0x800000) != 0 ? value - 0x1000000 : value;
+    }
+};
+
+} /* namespace card */
+} /* namespace card */
+} /* namespace calypso */
+} /* namespace keypop */
@@ -0,0 +1,177 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+
+#include "keypop/calypso/card/ArrayView.hpp"
+#include "keypop/calypso/card/transaction/AuditLogRecord.hpp"
+#include "keypop/calypso/card/transaction/spi/TransactionAuditSink.hpp"
+
+namespace keypop {
+namespace calypso {
+namespace card {
+namespace transaction {
+
+using keypop::calypso::card::ByteArrayView;
+using spi::TransactionAuditSink;
+
+/**
+ * Sequential reader of a binary audit log (see {@link AuditLogRecord} for the format).
+ *
+ * <p>The reader works directly on the provided memory area (e.g. a memory-mapped file) and never
+ * allocates: the records it produces hold views on that area, which must outlive them.
+ *
+ * <p>Usage:
+ *
+ * <pre>
+ * AuditLogReader reader(data);
+ * AuditLogRecord record;
+ * while (reader.next(record)) {
+ *     ...
+ * }
+ * </pre>
+ *
+ * @see AuditLogWriter
+ * @since 2.0.0
+ */
+class AuditLogReader final {
+public:
+    /**
+     * @param data The audit log.
+     * @since 2.0.0
+     */
+    explicit AuditLogReader(const ByteArrayView data)
+    : mData(data), mPosition(0), mCardSerialNumber(nullptr, 0) {}
+
+    /**
+     * Reads the next record, skipping the records of unknown type.
+     *
+     * <p>The card serial number of the returned record is the one of the last TRANSACTION record
+     * read.
+     *
+     * @param record The record to fill.
+     * @return False if the end of the log has been reached, in which case the record is left
+     *         unchanged.
+     * @throw std::invalid_argument If a record is truncated or malformed.
+     * @since 2.0.0
+     */
+    bool
+    next(AuditLogRecord& record) {
+        while (mPosition < mData.size()) {
+            if (mData.size() - mPosition < AuditLogRecord::HEADER_SIZE) {
+                throw std::invalid_argument("Truncated audit log record header");
+            }
+
+            const uint8_t type = mData[mPosition];
+            const size_t payloadSize = static_cast<size_t>(readInt(mPosition + 1, 2));
+            const size_t payloadPosition = mPosition + AuditLogRecord::HEADER_SIZE;
+            if (mData.size() - payloadPosition < payloadSize) {
+                throw std::invalid_argument("Truncated audit log record");
+            }
+
+            mPosition = payloadPosition + payloadSize;
+
+            if (type == static_cast<uint8_t>(AuditLogRecord::Type::TRANSACTION)) {
+                readTransaction(payloadPosition, payloadSize, record);
+                return true;
+            }
+
+            if (type == static_cast<uint8_t>(AuditLogRecord::Type::EXCHANGE)) {
+                readExchange(payloadPosition, payloadSize, record);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Restarts the reading from the beginning of the log.
+     *
+     * @since 2.0.0
+     */
+    void
+    rewind() {
+        mPosition = 0;
+        mCardSerialNumber = ByteArrayView(nullptr, 0);
+    }
+
+private:
+    uint64_t
+    readInt(const size_t position, const size_t size) const {
+        uint64_t value = 0;
+        for (size_t i = 0; i < size; i++) {
+            value = (value << 8) | mData[position + i];
+        }
+
+        return value;
+    }
+
+    void
+    readTransaction(const size_t position, const size_t size, AuditLogRecord& record) {
+        if (size < 8) {
+            throw std::invalid_argument("Malformed audit log TRANSACTION record");
+        }
+
+        mCardSerialNumber = ByteArrayView(mData.data() + position + 8, size - 8);
+        record = AuditLogRecord(
+            AuditLogRecord::Type::TRANSACTION,
+            TransactionAuditSink::Source::CARD,
+            readInt(position, 8),
+            mCardSerialNumber,
+            ByteArrayView(nullptr, 0),
+            ByteArrayView(nullptr, 0));
+    }
+
+    void
+    readExchange(const size_t position, const size_t size, AuditLogRecord& record) const {
+        if (size < 11) {
+            throw std::invalid_argument("Malformed audit log EXCHANGE record");
+        }
+
+        const size_t commandSize = static_cast<size_t>(readInt(position + 9, 2));
+        if (commandSize > size - 11) {
+            throw std::invalid_argument("Malformed audit log EXCHANGE record");
+        }
+
+        const uint8_t* command = mData.data() + position + 11;
+        record = AuditLogRecord(
+            AuditLogRecord::Type::EXCHANGE,
+            (mData[position] & AuditLogRecord::FLAG_CRYPTO_MODULE) != 0
+                ? TransactionAuditSink::Source::CRYPTO_MODULE
+                : TransactionAuditSink::Source::CARD,
+            readInt(position + 1, 8),
+            mCardSerialNumber,
+            ByteArrayView(command, commandSize),
+            ByteArrayView(command + commandSize, size - 11 - commandSize));
+    }
+
+    /**
+     *
+     */
+    const ByteArrayView mData;
+
+    /**
+     *
+     */
+    size_t mPosition;
+
+    /**
+     *
+     */
+    ByteArrayView mCardSerialNumber;
+};
+
+} /* namespace transaction */
+} /* namespace card */
+} /* namespace calypso */
+} /* namespace keypop */
@@ -0,0 +1,228 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include "keypop/calypso/card/ArrayView.hpp"
+#include "keypop/calypso/card/transaction/spi/TransactionAuditSink.hpp"
+
+namespace keypop {
+namespace calypso {
+namespace card {
+namespace transaction {
+
+using keypop::calypso::card::ByteArrayView;
+using spi::TransactionAuditSink;
+
+/**
+ * Record of a binary audit log, as produced by {@link AuditLogWriter} and read by {@link
+ * AuditLogReader}.
+ *
+ * <p>An audit log is a contiguous sequence of records, each one made of a type (1 byte), a payload
+ * length (2 bytes, big endian) and the payload itself:
+ *
+ * <ul>
+ *   <li>TRANSACTION: timestamp (8 bytes), card serial number (remaining bytes).
+ *   <li>EXCHANGE: flags (1 byte, bit 0 set for an exchange with the cryptographic module),
+ *       timestamp (8 bytes), command length (2 bytes), command, response (remaining bytes).
+ * </ul>
+ *
+ * <p>All integers are big endian and timestamps are expressed in microseconds since the Unix
+ * epoch. Records of unknown type are skipped by the reader, allowing the format to be extended.
+ *
+ * <p>The views held by a record refer to the audit log buffer and are only valid as long as it is.
+ *
+ * @since 2.0.0
+ */
+class AuditLogRecord final {
+public:
+    /**
+     * Type of an audit log record.
+     *
+     * @since 2.0.0
+     */
+    enum class Type : uint8_t {
+        /**
+         * Beginning of a transaction with a card.
+         *
+         * @since 2.0.0
+         */
+        TRANSACTION = 0x01,
+
+        /**
+         * APDU exchange with the card or the cryptographic module.
+         *
+         * @since 2.0.0
+         */
+        EXCHANGE = 0x02
+    };
+
+    /**
+     * Size of the header (type and payload length) of each record.
+     *
+     * @since 2.0.0
+     */
+    static const size_t HEADER_SIZE = 3;
+
+    /**
+     * Maximum size of the payload of a record.
+     *
+     * @since 2.0.0
+     */
+    static const size_t MAX_PAYLOAD_SIZE = 0xFFFF;
+
+    /**
+     * Bit of the flags of an EXCHANGE record set for an exchange with the cryptographic module.
+     *
+     * @since 2.0.0
+     */
+    static const uint8_t FLAG_CRYPTO_MODULE = 0x01;
+
+    /**
+     * Creates an empty TRANSACTION record.
+     *
+     * @since 2.0.0
+     */
+    AuditLogRecord()
+    : mType(Type::TRANSACTION)
+    , mSource(TransactionAuditSink::Source::CARD)
+    , mTimestamp(0)
+    , mCardSerialNumber(nullptr, 0)
+    , mCommand(nullptr, 0)
+    , mResponse(nullptr, 0) {
+    }
+
+    /**
+     * @param type The record type.
+     * @param source The exchange source (EXCHANGE records only).
+     * @param timestamp The timestamp in microseconds since the Unix epoch.
+     * @param cardSerialNumber The serial number of the card of the current transaction.
+     * @param command The command APDU (EXCHANGE records only).
+     * @param response The response APDU (EXCHANGE records only).
+     * @since 2.0.0
+     */
+    AuditLogRecord(
+        const Type type,
+        const TransactionAuditSink::Source source,
+        const uint64_t timestamp,
+        const ByteArrayView cardSerialNumber,
+        const ByteArrayView command,
+        const ByteArrayView response)
+    : mType(type)
+    , mSource(source)
+    , mTimestamp(timestamp)
+    , mCardSerialNumber(cardSerialNumber)
+    , mCommand(command)
+    , mResponse(response) {
+    }
+
+    /**
+     * Gets the record type.
+     *
+     * @return A non-null value.
+     * @since 2.0.0
+     */
+    Type
+    getType() const {
+        return mType;
+    }
+
+    /**
+     * Gets the source of the exchange (EXCHANGE records only).
+     *
+     * @return A non-null value.
+     * @since 2.0.0
+     */
+    TransactionAuditSink::Source
+    getSource() const {
+        return mSource;
+    }
+
+    /**
+     * Gets the timestamp of the record.
+     *
+     * @return A number of microseconds since the Unix epoch.
+     * @since 2.0.0
+     */
+    uint64_t
+    getTimestamp() const {
+        return mTimestamp;
+    }
+
+    /**
+     * Gets the serial number of the card of the transaction the record belongs to.
+     *
+     * @return An empty view if no TRANSACTION record precedes the record.
+     * @since 2.0.0
+     */
+    const ByteArrayView&
+    getCardSerialNumber() const {
+        return mCardSerialNumber;
+    }
+
+    /**
+     * Gets the command APDU (EXCHANGE records only).
+     *
+     * @return A view on the log buffer.
+     * @since 2.0.0
+     */
+    const ByteArrayView&
+    getCommand() const {
+        return mCommand;
+    }
+
+    /**
+     * Gets the response APDU, including the status word (EXCHANGE records only).
+     *
+     * @return A view on the log buffer, empty if no response has been received.
+     * @since 2.0.0
+     */
+    const ByteArrayView&
+    getResponse() const {
+        return mResponse;
+    }
+
+private:
+    /**
+     *
+     */
+    Type mType;
+
+    /**
+     *
+     */
+    TransactionAuditSink::Source mSource;
+
+    /**
+     *
+     */
+    uint64_t mTimestamp;
+
+    /**
+     *
+     */
+    ByteArrayView mCardSerialNumber;
+
+    /**
+     *
+     */
+    ByteArrayView mCommand;
+
+    /**
+     *
+     */
+    ByteArrayView mResponse;
+};
+
+} /* namespace transaction */
+} /* namespace card */
+} /* namespace calypso */
+} /* namespace keypop */
@@ -0,0 +1,193 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "keypop/calypso/card/ArrayView.hpp"
+#include "keypop/calypso/card/transaction/AuditLogRecord.hpp"
+#include "keypop/calypso/card/transaction/spi/TransactionAuditSink.hpp"
+
+namespace keypop {
+namespace calypso {
+namespace card {
+namespace transaction {
+
+using keypop::calypso::card::ByteArrayView;
+using spi::TransactionAuditSink;
+
+/**
+ * Audit sink appending the APDU exchanges to a contiguous buffer using the binary format described
+ * in {@link AuditLogRecord}.
+ *
+ * <p>The buffer only grows when its capacity is exceeded; {@link #clear()} keeps the capacity so
+ * that a writer reused across transactions does not allocate in steady state.
+ *
+ * <p>This class is not thread-safe.
+ *
+ * @see AuditLogReader
+ * @since 2.0.0
+ */
+class AuditLogWriter final : public TransactionAuditSink {
+public:
+    /**
+     * @param initialCapacity The initial capacity of the buffer, in bytes.
+     * @since 2.0.0
+     */
+    explicit AuditLogWriter(const size_t initialCapacity = 4096) {
+        mBuffer.reserve(initialCapacity);
+    }
+
+    /**
+     * Appends a TRANSACTION record timestamped with the current system time.
+     *
+     * @param cardSerialNumber The serial number of the card.
+     * @throw std::invalid_argument If the serial number is too long.
+     * @since 2.0.0
+     */
+    void
+    beginTransaction(const ByteArrayView cardSerialNumber) {
+        beginTransaction(now(), cardSerialNumber);
+    }
+
+    /**
+     * Appends a TRANSACTION record.
+     *
+     * @param timestamp The timestamp in microseconds since the Unix epoch.
+     * @param cardSerialNumber The serial number of the card.
+     * @throw std::invalid_argument If the serial number is too long.
+     * @since 2.0.0
+     */
+    void
+    beginTransaction(const uint64_t timestamp, const ByteArrayView cardSerialNumber) {
+        const size_t payloadSize = 8 + cardSerialNumber.size();
+        checkPayloadSize(payloadSize);
+
+        appendHeader(AuditLogRecord::Type::TRANSACTION, payloadSize);
+        appendInt(timestamp, 8);
+        mBuffer.insert(mBuffer.end(), cardSerialNumber.begin(), cardSerialNumber.end());
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The exchange is timestamped with the current system time.
+     *
+     * @since 2.0.0
+     */
+    void
+    onApduExchange(
+        const Source source, const ByteArrayView command, const ByteArrayView response) override {
+        appendExchange(source, now(), command, response);
+    }
+
+    /**
+     * Appends an EXCHANGE record.
+     *
+     * @param source The origin of the exchange.
+     * @param timestamp The timestamp in microseconds since the Unix epoch.
+     * @param command The command APDU.
+     * @param response The response APDU.
+     * @throw std::invalid_argument If the APDUs are too long.
+     * @since 2.0.0
+     */
+    void
+    appendExchange(
+        const Source source,
+        const uint64_t timestamp,
+        const ByteArrayView command,
+        const ByteArrayView response) {
+        const size_t payloadSize = 11 + command.size() + response.size();
+        checkPayloadSize(payloadSize);
+
+        appendHeader(AuditLogRecord::Type::EXCHANGE, payloadSize);
+        mBuffer.push_back(
+            source == Source::CRYPTO_MODULE ? AuditLogRecord::FLAG_CRYPTO_MODULE : 0x00);
+        appendInt(timestamp, 8);
+        appendInt(command.size(), 2);
+        mBuffer.insert(mBuffer.end(), command.begin(), command.end());
+        mBuffer.insert(mBuffer.end(), response.begin(), response.end());
+    }
+
+    /**
+     * Gets a view on the audit log.
+     *
+     * <p>The view is invalidated by any further write.
+     *
+     * @return An empty view if nothing has been written.
+     * @since 2.0.0
+     */
+    ByteArrayView
+    getData() const {
+        return ByteArrayView(mBuffer);
+    }
+
+    /**
+     * Gets the size of the audit log.
+     *
+     * @return A number of bytes.
+     * @since 2.0.0
+     */
+    size_t
+    size() const {
+        return mBuffer.size();
+    }
+
+    /**
+     * Discards the content of the audit log, keeping the allocated capacity.
+     *
+     * @since 2.0.0
+     */
+    void
+    clear() {
+        mBuffer.clear();
+    }
+
+private:
+    static uint64_t
+    now() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                         std::chrono::system_clock::now().time_since_epoch())
+                                         .count());
+    }
+
+    static void
+    checkPayloadSize(const size_t payloadSize) {
+        if (payloadSize > AuditLogRecord::MAX_PAYLOAD_SIZE) {
+            throw std::invalid_argument("Audit log record too long");
+        }
+    }
+
+    void
+    appendHeader(const AuditLogRecord::Type type, const size_t payloadSize) {
+        mBuffer.push_back(static_cast<uint8_t>(type));
+        appendInt(payloadSize, 2);
+    }
+
+    void
+    appendInt(const uint64_t value, const size_t size) {
+        for (size_t i = size; i > 0; i--) {
+            mBuffer.push_back(static_cast<uint8_t>(value >> (8 * (i - 1))));
+        }
+    }
+
+    /**
+     *
+     */
+    std::vector<uint8_t> mBuffer;
+};
+
+} /* namespace transaction */
+} /* namespace card */
+} /* namespace calypso */
+} /* namespace keypop */
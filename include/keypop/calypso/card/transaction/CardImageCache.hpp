@@ -0,0 +1,299 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "keypop/calypso/card/ArrayView.hpp"
+#include "keypop/calypso/card/card/CardImage.hpp"
+#include "keypop/calypso/card/card/FileKey.hpp"
+
+namespace keypop {
+namespace calypso {
+namespace card {
+namespace transaction {
+
+using keypop::calypso::card::ByteArrayView;
+using keypop::calypso::card::card::CardImage;
+using keypop::calypso::card::card::FileKey;
+
+/**
+ * Cache of the last known card images, keyed by application serial number and transaction
+ * counter.
+ *
+ * <p>A Calypso card decrements its transaction counter at each secure session opening. An image
+ * stored after a secure session is associated with the counter that the next opening is expected
+ * to report (the one reported by the opening of the stored session, minus 1), and is returned only
+ * when an opening reports this value, proving that no other secure session took place since.
+ *
+ * <p>The counter does not reveal the modifications made outside a secure session, so only the EFs
+ * declared with {@link #addCacheableFile(FileKey)} are served from the cache: their access
+ * conditions must forbid any modification outside a secure session.
+ *
+ * <p>When the cache holds its maximum number of entries, storing the image of a new card evicts
+ * the least recently used one, whose storage is then reused.
+ *
+ * <p>This class is not thread-safe.
+ *
+ * @see TransactionManager#setCardImageCache(std::shared_ptr)
+ * @since 2.0.0
+ */
+class CardImageCache final {
+public:
+    /**
+     * Maximum length of an application serial number.
+     *
+     * @since 2.0.0
+     */
+    static const size_t MAX_SERIAL_NUMBER_LENGTH = 8;
+
+    /**
+     * @param maxEntries The maximum number of cached card images.
+     * @throw std::invalid_argument If maxEntries is 0.
+     * @since 2.0.0
+     */
+    explicit CardImageCache(const size_t maxEntries) : mMaxEntries(maxEntries) {
+        if (maxEntries == 0) {
+            throw std::invalid_argument("maxEntries");
+        }
+
+        mEntries.reserve(maxEntries);
+    }
+
+    /**
+     * Not copyable: the entries refer to the nodes of the use order list.
+     */
+    CardImageCache(const CardImageCache&) = delete;
+
+    /**
+     * Not copyable: the entries refer to the nodes of the use order list.
+     */
+    CardImageCache& operator=(const CardImageCache&) = delete;
+
+    /**
+     * Declares an EF whose content may be served from the cache.
+     *
+     * @param file The EF, which must not be modifiable outside a secure session.
+     * @since 2.0.0
+     */
+    void
+    addCacheableFile(const FileKey file) {
+        const auto it = std::lower_bound(mCacheableFiles.begin(), mCacheableFiles.end(), file);
+        if (it == mCacheableFiles.end() || *it != file) {
+            mCacheableFiles.insert(it, file);
+        }
+    }
+
+    /**
+     * Indicates whether an EF has been declared with {@link #addCacheableFile(FileKey)}.
+     *
+     * @param file The EF.
+     * @return True if the content of the EF may be served from the cache.
+     * @since 2.0.0
+     */
+    bool
+    isCacheable(const FileKey file) const {
+        return std::binary_search(mCacheableFiles.begin(), mCacheableFiles.end(), file);
+    }
+
+    /**
+     * Stores a copy of the image of a card, replacing the previous one of the same card.
+     *
+     * @param serialNumber The application serial number of the card.
+     * @param transactionCounter The transaction counter that the next secure session opening is
+     *        expected to report.
+     * @param image The card image.
+     * @throw std::invalid_argument If the serial number is empty or longer than
+     *        {@link #MAX_SERIAL_NUMBER_LENGTH}.
+     * @since 2.0.0
+     */
+    void
+    put(const ByteArrayView serialNumber, const int transactionCounter, const CardImage& image) {
+        const Key key = toKey(serialNumber);
+
+        auto it = mEntries.find(key);
+        if (it == mEntries.end()) {
+            Entry entry;
+            if (mEntries.size() >= mMaxEntries) {
+                /* Reuses the storage and the list node of the least recently used entry */
+                const auto oldest = mEntries.find(mUseOrder.back());
+                entry.image = std::move(oldest->second.image);
+                mEntries.erase(oldest);
+                mUseOrder.back() = key;
+                mUseOrder.splice(mUseOrder.begin(), mUseOrder, std::prev(mUseOrder.end()));
+            } else {
+                mUseOrder.push_front(key);
+            }
+            entry.useOrderPosition = mUseOrder.begin();
+            it = mEntries.insert({key, std::move(entry)}).first;
+        } else {
+            markUsed(it->second);
+        }
+
+        it->second.transactionCounter = transactionCounter;
+        it->second.image = image;
+    }
+
+    /**
+     * Gets the cached image of a card, provided that no secure session took place since it was
+     * stored.
+     *
+     * @param serialNumber The application serial number of the card.
+     * @param transactionCounter The transaction counter reported by the secure session opening.
+     * @return Null if no image of the card is cached, or if the cached image is associated with
+     *         another transaction counter. The pointer is invalidated by the next modification of
+     *         the cache.
+     * @throw std::invalid_argument If the serial number is empty or longer than
+     *        {@link #MAX_SERIAL_NUMBER_LENGTH}.
+     * @since 2.0.0
+     */
+    const CardImage*
+    find(const ByteArrayView serialNumber, const int transactionCounter) {
+        const auto it = mEntries.find(toKey(serialNumber));
+        if (it == mEntries.end() || it->second.transactionCounter != transactionCounter) {
+            return nullptr;
+        }
+
+        markUsed(it->second);
+
+        return &it->second.image;
+    }
+
+    /**
+     * Removes the cached image of a card, if any.
+     *
+     * @param serialNumber The application serial number of the card.
+     * @throw std::invalid_argument If the serial number is empty or longer than
+     *        {@link #MAX_SERIAL_NUMBER_LENGTH}.
+     * @since 2.0.0
+     */
+    void
+    remove(const ByteArrayView serialNumber) {
+        const auto it = mEntries.find(toKey(serialNumber));
+        if (it != mEntries.end()) {
+            mUseOrder.erase(it->second.useOrderPosition);
+            mEntries.erase(it);
+        }
+    }
+
+    /**
+     * Removes all the cached images (the cacheable EFs remain declared).
+     *
+     * @since 2.0.0
+     */
+    void
+    clear() {
+        mEntries.clear();
+        mUseOrder.clear();
+    }
+
+    /**
+     * Gets the number of cached images.
+     *
+     * @return A value lower or equal to the maximum number of entries.
+     * @since 2.0.0
+     */
+    size_t
+    size() const {
+        return mEntries.size();
+    }
+
+private:
+    /**
+     * Serial number packed into an integer, together with its length.
+     */
+    struct Key {
+        uint64_t value;
+        size_t length;
+
+        bool
+        operator==(const Key& o) const {
+            return value == o.value && length == o.length;
+        }
+    };
+
+    /**
+     *
+     */
+    struct KeyHash {
+        size_t
+        operator()(const Key& key) const {
+            return std::hash<uint64_t>()(key.value ^ (static_cast<uint64_t>(key.length) << 59));
+        }
+    };
+
+    /**
+     *
+     */
+    struct Entry {
+        int transactionCounter = 0;
+        std::list<Key>::iterator useOrderPosition;
+        CardImage image;
+    };
+
+    /**
+     * Moves the entry to the front of the use order.
+     */
+    void
+    markUsed(const Entry& entry) {
+        mUseOrder.splice(mUseOrder.begin(), mUseOrder, entry.useOrderPosition);
+    }
+
+    /**
+     *
+     */
+    static Key
+    toKey(const ByteArrayView serialNumber) {
+        if (serialNumber.empty() || serialNumber.size() > MAX_SERIAL_NUMBER_LENGTH) {
+            throw std::invalid_argument("serialNumber");
+        }
+
+        Key key = {0, serialNumber.size()};
+        for (const uint8_t b : serialNumber) {
+            key.value = (key.value << 8) | b;
+        }
+
+        return key;
+    }
+
+    /**
+     *
+     */
+    const size_t mMaxEntries;
+
+    /**
+     *
+     */
+    std::unordered_map<Key, Entry, KeyHash> mEntries;
+
+    /**
+     * Keys of the entries, most recently used first.
+     */
+    std::list<Key> mUseOrder;
+
+    /**
+     * Sorted.
+     */
+    std::vector<FileKey> mCacheableFiles;
+};
+
+} /* namespace transaction */
+} /* namespace card */
+} /* namespace calypso */
+} /* namespace keypop */
@@ -12,7 +12,7 @@
 #include <memory>
 #include <stdexcept>
 
-#include "keypop/calypso/card/TransactionManager.hpp"
+#include "keypop/calypso/card/transaction/TransactionManager.hpp"
 
 namespace keypop {
 namespace calypso {
@@ -30,14 +30,13 @@ namespace transaction {
  *
  * @since 2.0.0
  */
-template <typename T>
-class FreeTransactionManager : public TransactionManager<T> {
+class FreeTransactionManager : public TransactionManager<FreeTransactionManager> {
 public:
     /**
      * Virtual destructor.
      */
     virtual ~FreeTransactionManager() = default;
-}
+};
 
 } /* namespace transaction */
 } /* namespace card */
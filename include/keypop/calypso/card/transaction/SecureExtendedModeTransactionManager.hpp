@@ -12,6 +12,8 @@
 #include <memory>
 #include <stdexcept>
 
+#include "keypop/calypso/card/transaction/SecureSymmetricCryptoTransactionManager.hpp"
+
 namespace keypop {
 namespace calypso {
 namespace card {
@@ -30,8 +32,8 @@ namespace transaction {
  *
  * @since 2.0.0
  */
-template <typename T>
-class SecureExtendedModeTransactionManager : public SecureSymmetricCryptoTransactionManager<T> {
+class SecureExtendedModeTransactionManager
+: public SecureSymmetricCryptoTransactionManager<SecureExtendedModeTransactionManager> {
 public:
     /**
      * Requests to mutually authenticate the card and the terminal before the secure session is
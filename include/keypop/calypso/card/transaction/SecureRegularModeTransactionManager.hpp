@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include "keypop/calypso/card/transaction/SecureSymmetricCryptoTransactionManager.hpp"
+
 namespace keypop {
 namespace calypso {
 namespace card {
@@ -27,8 +29,8 @@ namespace transaction {
  *
  * @since 2.0.0
  */
-template <typename T>
-class SecureRegularModeTransactionManager : public SecureRegularModeTransactionManager<T> {
+class SecureRegularModeTransactionManager
+: public SecureSymmetricCryptoTransactionManager<SecureRegularModeTransactionManager> {
 public:
     /**
      * Virtual destructor.
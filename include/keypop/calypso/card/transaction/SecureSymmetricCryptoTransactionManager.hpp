@@ -11,9 +11,10 @@
 
 #include <vector>
 
-#include "keypop/calypso/card/SvAction.hpp"
-#include "keypop/calypso/card/SvOperation.hpp"
 #include "keypop/calypso/card/WriteAccessLevel.hpp"
+#include "keypop/calypso/card/transaction/SecureTransactionManager.hpp"
+#include "keypop/calypso/card/transaction/SvAction.hpp"
+#include "keypop/calypso/card/transaction/SvOperation.hpp"
 
 namespace keypop {
 namespace calypso {
@@ -27,6 +28,20 @@ namespace transaction {
  * <p>See {@link SecureTransactionManager} parent interface for more information and details of
  * available card operations.
  *
+ * <p>When the prepared commands are processed asynchronously using {@link
+ * TransactionManager#processCommandsAsync(ChannelControl, CardTransactionExecutor,
+ * std::function)}, the following additional rules apply:
+ *
+ * <ul>
+ *   <li>The exchanges with the cryptographic module are run as steps of the transaction on the
+ *       provided executor, interleaved with the card exchanges in the same order as in synchronous
+ *       mode. The crypto extension must therefore accept being called from any executor thread.
+ *   <li>The secure session state (opened, closed, canceled) is only updated once the completion
+ *       callback has been invoked.
+ *   <li>If the processing fails while a secure session is open, the session is canceled as in
+ *       synchronous mode before the completion callback is invoked.
+ * </ul>
+ *
  * @param <T> The type of the lowest level child object.
  * @since 2.0.0
  */
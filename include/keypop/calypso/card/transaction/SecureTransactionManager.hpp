@@ -10,12 +10,19 @@
 #pragma once
 
 #include <memory>
+#include <typeinfo>
+
+#include "keypop/calypso/card/transaction/SessionBufferUsage.hpp"
+#include "keypop/calypso/card/transaction/TransactionManager.hpp"
+#include "keypop/calypso/card/transaction/spi/CardTransactionCryptoExtension.hpp"
 
 namespace keypop {
 namespace calypso {
 namespace card {
 namespace transaction {
 
+using spi::CardTransactionCryptoExtension;
+
 /**
  * Contains operations common to all card transactions secured by cryptographic algorithms.
  *
@@ -26,7 +33,7 @@ namespace transaction {
  * @since 2.0.0
  */
 template <typename T>
-class SecureTransactionManager : public SecureTransactionManager<T> {
+class SecureTransactionManager : public TransactionManager<T> {
 public:
     /**
      * Returns the associated {@link CardTransactionCryptoExtension} instance.
@@ -71,6 +78,40 @@ public:
      * @since 1.6.0
      */
     virtual SecureTransactionManager& prepareCancelSecureSession() = 0;
+
+    /**
+     * Computes, without any exchange with the card or the cryptographic module, the projected
+     * session buffer usage, the number of secure sessions and the number of card APDUs required to
+     * process the currently prepared commands.
+     *
+     * <p>This allows the application to reorder or trim the prepared modifications before calling
+     * {@link #processCommands(ChannelControl)} so that they fit in a single session, instead of
+     * discovering the overflow through a {@link SessionBufferOverflowException} or an unwanted
+     * multiple session.
+     *
+     * <p>The projection takes into account the modifications already made in the current secure
+     * session, if any.
+     *
+     * @return A new projection reflecting the current state of the prepared commands.
+     * @since 2.0.0
+     */
+    virtual SessionBufferUsage getSessionBufferUsage() const = 0;
+
+    /**
+     * Indicates whether the last secure session opening has consumed the data obtained by the
+     * "Pre-Open" command executed during the selection, thus saving the "Open Secure Session"
+     * exchange with the card.
+     *
+     * <p>The pre-opening data is not used when one of the conditions listed in {@link
+     * CalypsoCardSelectionExtension#preparePreOpenSecureSession(WriteAccessLevel)} or {@link
+     * CalypsoCardSelectionExtension#preparePreOpenSecureSessionInPkiMode()} is not met, or if no
+     * "Pre-Open" command has been prepared.
+     *
+     * @return False if no secure session has been opened yet or if the last secure session has
+     *         been opened with an "Open Secure Session" exchange with the card.
+     * @since 2.0.0
+     */
+    virtual bool isPreOpenSecureSessionDataUsed() const = 0;
 };
 
 } /* namespace transaction */
@@ -0,0 +1,119 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+namespace keypop {
+namespace calypso {
+namespace card {
+namespace transaction {
+
+/**
+ * Projection of the resources needed to process the currently prepared commands.
+ *
+ * <p>Buffer sizes are expressed in the unit used by the card for its session modifications buffer:
+ * a number of bytes or a number of commands depending on the product (see {@link
+ * CalypsoCard#getSessionModification()}).
+ *
+ * @see SecureTransactionManager#getSessionBufferUsage()
+ * @since 2.0.0
+ */
+class SessionBufferUsage final {
+public:
+    /**
+     * @param bufferSize The capacity of the card session modifications buffer.
+     * @param bufferUsage The total amount of buffer consumed by the prepared modifications.
+     * @param sessionsCount The number of secure sessions needed.
+     * @param apduCount The number of card APDUs that will be sent.
+     * @since 2.0.0
+     */
+    SessionBufferUsage(
+        const int bufferSize, const int bufferUsage, const int sessionsCount, const int apduCount)
+    : mBufferSize(bufferSize)
+    , mBufferUsage(bufferUsage)
+    , mSessionsCount(sessionsCount)
+    , mApduCount(apduCount) {
+    }
+
+    /**
+     * Gets the capacity of the card session modifications buffer.
+     *
+     * @return A positive value.
+     * @since 2.0.0
+     */
+    int
+    getBufferSize() const {
+        return mBufferSize;
+    }
+
+    /**
+     * Gets the total amount of buffer consumed by the prepared modification commands, all sessions
+     * included.
+     *
+     * @return A positive or zero value.
+     * @since 2.0.0
+     */
+    int
+    getBufferUsage() const {
+        return mBufferUsage;
+    }
+
+    /**
+     * Gets the number of secure sessions the prepared commands will need.
+     *
+     * <p>A value greater than 1 means that the modifications do not fit in the buffer and that the
+     * processing will either split them into several sessions (multiple session mode enabled) or
+     * fail with a {@link SessionBufferOverflowException}.
+     *
+     * @return Zero if no secure session is prepared or in progress.
+     * @since 2.0.0
+     */
+    int
+    getSessionsCount() const {
+        return mSessionsCount;
+    }
+
+    /**
+     * Gets the number of card APDUs that will be sent to process the prepared commands, including
+     * the session management commands induced by multiple sessions.
+     *
+     * @return A positive or zero value.
+     * @since 2.0.0
+     */
+    int
+    getApduCount() const {
+        return mApduCount;
+    }
+
+private:
+    /**
+     *
+     */
+    int mBufferSize;
+
+    /**
+     *
+     */
+    int mBufferUsage;
+
+    /**
+     *
+     */
+    int mSessionsCount;
+
+    /**
+     *
+     */
+    int mApduCount;
+};
+
+} /* namespace transaction */
+} /* namespace card */
+} /* namespace calypso */
+} /* namespace keypop */
@@ -11,7 +11,7 @@
 
 #include <cstdint>
 
-#include "keypop/calypso/card/WriteAccesLevel.hpp"
+#include "keypop/calypso/card/WriteAccessLevel.hpp"
 
 namespace keypop {
 namespace calypso {
@@ -9,19 +9,37 @@
 
 #pragma once
 
+#include <cstddef>
+#include <exception>
+#include <functional>
 #include <map>
+#include <memory>
+#include <utility>
 #include <vector>
 
+#include "keypop/calypso/card/ArrayView.hpp"
 #include "keypop/calypso/card/GetDataTag.hpp"
-#include "keypop/calypso/card/SearchCommandData.hpp"
 #include "keypop/calypso/card/SelectFileControl.hpp"
+#include "keypop/calypso/card/card/CalypsoCard.hpp"
+#include "keypop/calypso/card/transaction/CardImageCache.hpp"
 #include "keypop/calypso/card/transaction/ChannelControl.hpp"
+#include "keypop/calypso/card/transaction/SearchCommandData.hpp"
+#include "keypop/calypso/card/transaction/spi/CardTransactionExecutor.hpp"
+#include "keypop/calypso/card/transaction/spi/CardTransactionObserver.hpp"
+#include "keypop/calypso/card/transaction/spi/TransactionAuditSink.hpp"
+#include "keypop/reader/CardReader.hpp"
 
 namespace keypop {
 namespace calypso {
 namespace card {
 namespace transaction {
 
+using keypop::calypso::card::card::CalypsoCard;
+using keypop::reader::CardReader;
+using spi::CardTransactionExecutor;
+using spi::CardTransactionObserver;
+using spi::TransactionAuditSink;
+
 /**
  * Contains operations common to all card transactions.
  *
@@ -47,6 +65,24 @@ namespace transaction {
  *   <li>Input data length: [1..250] or [1..32767] for binary files
  * </ul>
  *
+ * <p>Read coalescing: to minimize the number of APDUs, a read prepared with {@link
+ * #prepareReadRecord(uint8_t, int)}, {@link #prepareReadCounter(uint8_t, int)}, {@link
+ * #prepareReadRecords(uint8_t, int, int, int)}, {@link #prepareReadRecordsPartially(uint8_t, int,
+ * int, int, int)} or {@link #prepareReadBinary(uint8_t, int, int)} is merged into a read of the
+ * same kind and of the same EF prepared earlier when all the following conditions are met:
+ *
+ * <ul>
+ *   <li>Both reads have the same shape (same record, same record size, or same records for the
+ *       partial reads) and their ranges (records or bytes) overlap or are adjacent.
+ *   <li>No modification of this EF and no secure session command has been prepared in between;
+ *       other commands may have been.
+ *   <li>The merged read fits in a single APDU given the payload capacity of the card.
+ * </ul>
+ *
+ * <p>A read that is not merged is split into the minimum number of APDUs allowed by the payload
+ * capacity of the card. The resulting number of APDUs can be checked with {@link
+ * #getPreparedApduCount()}.
+ *
  * @param <T> The type of the lowest level child object.
  * @since 2.0.0
  */
@@ -154,6 +190,10 @@ public:
      *       the security of the session.
      * </ul>
      *
+     * <p>The read is coalesced with the other prepared reads as described in {@link
+     * TransactionManager}; each record occupies its size plus 2 bytes in the response. Since an
+     * APDU addresses a single EF, reads of different SFIs always produce distinct APDUs.
+     *
      * @param sfi The SFI of the EF.
      * @param fromRecordNumber The number of the first record to read.
      * @param toRecordNumber The number of the last record to read.
@@ -191,6 +231,13 @@ public:
      *       the security of the session.
      * </ul>
      *
+     * <p>The read is coalesced with the other prepared reads as described in {@link
+     * TransactionManager}.
+     *
+     * <p>If enabled with {@link #enableCachedReadsSkipping()}, the read is dropped when all the
+     * requested bytes are known in the {@link CalypsoCard} image (see {@link
+     * #enableCachedReadsSkipping()}).
+     *
      * @param sfi The SFI of the EF.
      * @param fromRecordNumber The number of the first record to read.
      * @param toRecordNumber The number of the last record to read.
@@ -231,6 +278,15 @@ public:
      *       the security of the session.
      * </ul>
      *
+     * <p>The read is coalesced with the other prepared reads as described in {@link
+     * TransactionManager}. An offset beyond 255 cannot be encoded along with the SFI: such a read
+     * addresses the current EF and is preceded by a one-byte read at offset 0 selecting the EF,
+     * unless the previous prepared command already addresses it.
+     *
+     * <p>If enabled with {@link #enableCachedReadsSkipping()}, the read is dropped when all the
+     * requested bytes are known in the {@link CalypsoCard} image (see {@link
+     * #enableCachedReadsSkipping()}).
+     *
      * @param sfi The SFI of the EF.
      * @param offset The offset (0 indicates the first byte).
      * @param nbBytesToRead The number of bytes to read.
@@ -310,11 +366,11 @@ public:
      * @return The current instance.
      * @throw UnsupportedOperationException If the "Search Record Multiple" command is not available
      *        for this card.
-     * @throw IllegalArgumentException If the input data is inconsistent.
+     * @throw IllegalArgumentException If the input data is null or inconsistent.
      * @see SearchCommandData
      * @since 1.1.0
      */
-    virtual T& prepareSearchRecords(const SearchCommandData data) = 0;
+    virtual T& prepareSearchRecords(const std::shared_ptr<SearchCommandData> data) = 0;
 
     /**
      * Schedules the execution of a "Verify Pin" command without PIN presentation in order to get
@@ -348,6 +404,24 @@ public:
      */
     virtual T& prepareAppendRecord(const uint8_t sfi, const std::vector<uint8_t>& recordData) = 0;
 
+    /**
+     * Schedules the execution of an "Append Record" command to adds the data provided in the
+     * indicated "cyclic" file.
+     *
+     * <p>Same as {@link #prepareAppendRecord(byte, byte[])} but the record data is provided as a
+     * non-owning view, allowing data held in a caller buffer (e.g. on the stack) to be used without
+     * any allocation. The data is copied into the prepared command before this method returns.
+     *
+     * @param sfi The sfi to select.
+     * @param recordData A view on the new record data to write.
+     * @return The current instance.
+     * @throw IllegalArgumentException If one of the provided argument is out of range.
+     * @throw SessionBufferOverflowException If the command will overflow the modifications buffer
+     *        size and the multiple session is not allowed.
+     * @since 2.0.0
+     */
+    virtual T& prepareAppendRecord(const uint8_t sfi, const ByteArrayView recordData) = 0;
+
     /**
      * Schedules the execution of an "Update Record" command to overwrites the target file's record
      * contents with the provided data.
@@ -372,6 +446,27 @@ public:
         const uint8_t sfi, const int recordNumber, const std::vector<uint8_t>& recordData)
         = 0;
 
+    /**
+     * Schedules the execution of an "Update Record" command to overwrites the target file's record
+     * contents with the provided data.
+     *
+     * <p>Same as {@link #prepareUpdateRecord(byte, int, byte[])} but the record data is provided as
+     * a non-owning view. The data is copied into the prepared command before this method returns.
+     *
+     * @param sfi The sfi to select.
+     * @param recordNumber The record to update.
+     * @param recordData A view on the new record data. If length {@code <} RecSize, bytes beyond
+     *        length are left unchanged.
+     * @return The current instance.
+     * @throw IllegalArgumentException If one of the provided argument is out of range.
+     * @throw SessionBufferOverflowException If the command will overflow the modifications buffer
+     *        size and the multiple session is not allowed.
+     * @since 2.0.0
+     */
+    virtual T& prepareUpdateRecord(
+        const uint8_t sfi, const int recordNumber, const ByteArrayView recordData)
+        = 0;
+
     /**
      * Schedules the execution of a "Write Record" command to updates the target file's record
      * contents with the result of a binary OR between the existing data and the provided data.
@@ -396,6 +491,27 @@ public:
         const uint8_t sfi, const int recordNumber, const std::vector<uint8_t>& recordData)
         = 0;
 
+    /**
+     * Schedules the execution of a "Write Record" command to updates the target file's record
+     * contents with the result of a binary OR between the existing data and the provided data.
+     *
+     * <p>Same as {@link #prepareWriteRecord(byte, int, byte[])} but the record data is provided as
+     * a non-owning view. The data is copied into the prepared command before this method returns.
+     *
+     * @param sfi The sfi to select.
+     * @param recordNumber The record to write.
+     * @param recordData A view on the data to overwrite in the record. If length {@code <}
+     *        RecSize, bytes beyond length are left unchanged.
+     * @return The current instance.
+     * @throw IllegalArgumentException If one of the provided argument is out of range.
+     * @throw SessionBufferOverflowException If the command will overflow the modifications buffer
+     *        size and the multiple session is not allowed.
+     * @since 2.0.0
+     */
+    virtual T& prepareWriteRecord(
+        const uint8_t sfi, const int recordNumber, const ByteArrayView recordData)
+        = 0;
+
     /**
      * Schedules the execution of one or multiple "Update Binary" command to replace the indicated
      * data of a "binary" file with the new data given from the indicated offset.
@@ -419,6 +535,26 @@ public:
     prepareUpdateBinary(const uint8_t sfi, const int offset, const std::vector<uint8_t>& data)
         = 0;
 
+    /**
+     * Schedules the execution of one or multiple "Update Binary" command to replace the indicated
+     * data of a "binary" file with the new data given from the indicated offset.
+     *
+     * <p>Same as {@link #prepareUpdateBinary(byte, int, byte[])} but the data is provided as a
+     * non-owning view. The data is copied into the prepared command(s) before this method returns.
+     *
+     * @param sfi The SFI of the EF to select.
+     * @param offset The offset (0 indicates the first byte).
+     * @param data A view on the new data.
+     * @return The current instance.
+     * @throw UnsupportedOperationException If this command is not supported by this card.
+     * @throw IllegalArgumentException If one of the provided argument is out of range.
+     * @throw SessionBufferOverflowException If the command will overflow the modifications buffer
+     *        size and the multiple session is not allowed.
+     * @since 2.0.0
+     */
+    virtual T& prepareUpdateBinary(const uint8_t sfi, const int offset, const ByteArrayView data)
+        = 0;
+
     /**
      * Schedules the execution of one or multiple "Write Binary" commands to write over the
      * indicated data of a "binary" file. The new data will be the result of a binary OR operation
@@ -443,6 +579,26 @@ public:
     prepareWriteBinary(const uint8_t sfi, const int offset, const std::vector<uint8_t>& data)
         = 0;
 
+    /**
+     * Schedules the execution of one or multiple "Write Binary" commands to write over the
+     * indicated data of a "binary" file.
+     *
+     * <p>Same as {@link #prepareWriteBinary(byte, int, byte[])} but the data is provided as a
+     * non-owning view. The data is copied into the prepared command(s) before this method returns.
+     *
+     * @param sfi The SFI of the EF to select.
+     * @param offset The offset (0 indicates the first byte).
+     * @param data A view on the data to write over the existing data.
+     * @return The current instance.
+     * @throw UnsupportedOperationException If this command is not supported by this card.
+     * @throw IllegalArgumentException If one of the provided argument is out of range.
+     * @throw SessionBufferOverflowException If the command will overflow the modifications buffer
+     *        size and the multiple session is not allowed.
+     * @since 2.0.0
+     */
+    virtual T& prepareWriteBinary(const uint8_t sfi, const int offset, const ByteArrayView data)
+        = 0;
+
     /**
      * Schedules the execution of an "Increase" command to increase the target counter.
      *
@@ -490,6 +646,36 @@ public:
         const uint8_t sfi, const std::map<const int, const int>& counterNumberToIncValueMap)
         = 0;
 
+    /**
+     * Schedules the execution of an "Increase Multiple" command or multiple "Increase" commands to
+     * increase multiple target counters at the same time.
+     *
+     * <p>Same as {@link #prepareIncreaseCounters(byte, Map)} but the counters are provided as a
+     * flat array of (counter number, increment value) pairs, which can be held in a caller buffer
+     * without any allocation:
+     *
+     * <pre>{@code
+     * const std::pair<int, int> increments[] = {{1, 10}, {4, 2}};
+     * transaction.prepareIncreaseCounters(sfi, increments);
+     * }</pre>
+     *
+     * <p>The pairs are processed in ascending order of counter number, whatever their order in the
+     * array.
+     *
+     * @param sfi SFI of the EF to select.
+     * @param counterNumberToIncValues A view on the pairs of counter numbers to be incremented and
+     *        their associated increment values.
+     * @return The current instance.
+     * @throw IllegalArgumentException If one of the provided argument is out of range, if the array
+     *        is empty or if a counter number appears more than once.
+     * @throw SessionBufferOverflowException If the command will overflow the modifications buffer
+     *        size and the multiple session is not allowed.
+     * @since 2.0.0
+     */
+    virtual T& prepareIncreaseCounters(
+        const uint8_t sfi, const ArrayView<std::pair<int, int>> counterNumberToIncValues)
+        = 0;
+
     /**
      * Schedules the execution of a "Decrease" command to decrease the target counter.
      *
@@ -537,6 +723,31 @@ public:
         const uint8_t sfi, const std::map<const int, const int>& counterNumberToDecValueMap)
         = 0;
 
+    /**
+     * Schedules the execution of a "Decrease Multiple" command or multiple "Decrease" commands to
+     * decrease multiple target counters at the same time.
+     *
+     * <p>Same as {@link #prepareDecreaseCounters(byte, Map)} but the counters are provided as a
+     * flat array of (counter number, decrement value) pairs, which can be held in a caller buffer
+     * without any allocation.
+     *
+     * <p>The pairs are processed in ascending order of counter number, whatever their order in the
+     * array.
+     *
+     * @param sfi SFI of the EF to select.
+     * @param counterNumberToDecValues A view on the pairs of counter numbers to be decremented and
+     *        their associated decrement values.
+     * @return The current instance.
+     * @throw IllegalArgumentException If one of the provided argument is out of range, if the array
+     *        is empty or if a counter number appears more than once.
+     * @throw SessionBufferOverflowException If the command will overflow the modifications buffer
+     *        size and the multiple session is not allowed.
+     * @since 2.0.0
+     */
+    virtual T& prepareDecreaseCounters(
+        const uint8_t sfi, const ArrayView<std::pair<int, int>> counterNumberToDecValues)
+        = 0;
+
     /**
      * Schedules the execution of an "Increase" or "Decrease" command to set the value of the target
      * counter.
@@ -639,6 +850,82 @@ public:
      */
     virtual T& prepareChangePin(const std::vector<uint8_t>& newPin) = 0;
 
+    /**
+     * Enables the dropping of the reads whose data is already present in the {@link CalypsoCard}
+     * image, at the time they are prepared.
+     *
+     * <p>A read is dropped only when earlier reads or modifications fully cover it, as tracked by
+     * {@link CardImage#isKnown(FileKey, uint8_t, size_t, size_t)}: the zero padding of a record
+     * partially read from an offset is not considered as known data, and a read of whole records
+     * requires the whole records to have been read or set (see {@link
+     * CardImage#isComplete(FileKey, uint8_t)}).
+     *
+     * <p>This applies to the "Read Records", "Read Record Multiple", "Read Binary" and counter
+     * reads prepared outside a secure session only: inside a secure session, the reads are always
+     * sent to the card since they are part of the session authentication. The reads prepared during
+     * the selection are considered as cached data.
+     *
+     * <p>The application must make sure that the card image is up to date, i.e. that the card has
+     * not been modified by another terminal since the data was read. The setting is kept after a
+     * call to {@link #reset(std::shared_ptr, std::shared_ptr)}.
+     *
+     * <p>Disabled by default.
+     *
+     * @return The current instance.
+     * @since 2.0.0
+     */
+    virtual T& enableCachedReadsSkipping() = 0;
+
+    /**
+     * Sets a cache of card images used to serve the reads of the cards already seen.
+     *
+     * <p>The image of the card is stored in the cache when a secure session is closed (not
+     * cancelled), associated with the transaction counter that the next opening is expected to
+     * report (see {@link CardImageCache}). A modification of a cacheable EF processed outside a
+     * secure session removes the image of the card from the cache.
+     *
+     * <p>Once a secure session opening processed since the last reset has reported the counter of
+     * a cached image, a read of a cacheable EF (see {@link
+     * CardImageCache#addCacheableFile(FileKey)}) is served from the cache when the image contains
+     * the requested data, until the session is closed or a modification of the card is processed,
+     * and unless a modification of the EF has been prepared before the read. Such a read sends no
+     * command (it is not counted by {@link #getPreparedApduCount()}): the data is copied into the
+     * {@link CalypsoCard} image during the processing, which reports it in
+     * {@link CalypsoCard#getChanges()}. The served data is not part of the session authentication;
+     * its freshness is proven by the transaction counter, which is.
+     *
+     * <p>The reads prepared before the transaction counter is reported by an opening are always
+     * sent to the card.
+     *
+     * <p>No cache is set by default. The cache remains set after a call to {@link
+     * #reset(std::shared_ptr, std::shared_ptr)} and may be shared by several managers used
+     * sequentially.
+     *
+     * @param cache The cache to use, or null to remove the current one.
+     * @return The current instance.
+     * @throw IllegalStateException If an asynchronous processing is in progress (see {@link
+     *        #processCommandsAsync(ChannelControl, CardTransactionExecutor, std::function)}).
+     * @see CardImageCache
+     * @since 2.0.0
+     */
+    virtual T& setCardImageCache(const std::shared_ptr<CardImageCache> cache) = 0;
+
+    /**
+     * Returns the number of card APDUs that the processing of the currently prepared commands will
+     * produce, after the coalescing of the reads and the splitting of the commands exceeding the
+     * payload capacity of the card.
+     *
+     * <p>This count does not take into account the exchanges with the cryptographic module nor
+     * the additional exchanges that may be required in contact mode (e.g. "Get Response"), nor
+     * the reads served from the card image cache (see {@link
+     * #setCardImageCache(std::shared_ptr)}).
+     *
+     * @return A positive or zero value.
+     * @see #prepareReadRecords(uint8_t, int, int, int)
+     * @since 2.0.0
+     */
+    virtual int getPreparedApduCount() const = 0;
+
     /**
      * Processes all previously prepared commands and closes the physical channel if requested.
      *
@@ -669,18 +956,139 @@ public:
      *        authentic because the MAC of the card is incorrect.
      * @throw SelectFileException If a "Select File" prepared card command indicated that the file
      *        was not found.
+     * @throw IllegalStateException If an asynchronous processing is in progress (see {@link
+     *        #processCommandsAsync(ChannelControl, CardTransactionExecutor, std::function)}).
      * @since 1.6.0
      */
-    virtual T processCommands(const ChannelControl channelControl) = 0;
+    virtual T& processCommands(const ChannelControl channelControl) = 0;
+
+    /**
+     * Processes all previously prepared commands asynchronously and closes the physical channel if
+     * requested.
+     *
+     * <p>This method has the same behavior as {@link #processCommands(ChannelControl)} but returns
+     * immediately: the processing is split into successive steps, each performing at most one card
+     * exchange, which are submitted one after the other to the provided executor. The calling
+     * thread is never held for the card exchanges, and an executor thread is only held for one
+     * exchange at a time.
+     *
+     * <p>The completion callback is invoked exactly once, from an executor thread, when the
+     * processing is over. Its argument is null if the processing succeeded, or holds one of the
+     * exceptions documented in {@link #processCommands(ChannelControl)} otherwise.
+     *
+     * <p>Until the completion callback has been invoked, the application must not access the
+     * manager and its {@link CalypsoCard}. The only exceptions are the following methods, which
+     * raise an IllegalStateException instead of altering the transaction in progress: {@link
+     * #processCommands(ChannelControl)}, this method, {@link #reset(std::shared_ptr,
+     * std::shared_ptr)}, {@link #setCardImageCache(std::shared_ptr)}, {@link
+     * #setTransactionObserver(std::shared_ptr)}, {@link #setTransactionAuditSink(std::shared_ptr)}
+     * and {@link #setTransactionAuditDataMaxSize(size_t)}. Calling any other method meanwhile has
+     * an undefined behavior.
+     *
+     * @param channelControl Policy for managing the physical channel after executing commands to
+     *        the card.
+     * @param executor The executor in charge of running the processing steps.
+     * @param completionCallback The function to call when the processing is over.
+     * @throw IllegalArgumentException If the executor is null or the callback is empty.
+     * @throw IllegalStateException If an asynchronous processing is already in progress.
+     * @see #processCommands(ChannelControl)
+     * @since 2.0.0
+     */
+    virtual void processCommandsAsync(
+        const ChannelControl channelControl,
+        const std::shared_ptr<CardTransactionExecutor> executor,
+        const std::function<void(const std::exception_ptr)>& completionCallback)
+        = 0;
+
+    /**
+     * Rebinds the manager to a new card and reader in order to operate a new transaction, reusing
+     * the internal storage (command list, buffers) allocated for the previous transactions.
+     *
+     * <p>This allows an application to keep one manager per reader and reuse it for each new card
+     * instead of creating a new manager through the {@code CalypsoCardApiFactory} at each
+     * transaction.
+     *
+     * <p>All prepared and not yet processed commands are discarded, as well as the audit data of
+     * the previous transaction. The settings provided at creation time (e.g. the security setting)
+     * are kept.
+     *
+     * @param cardReader The card reader to be used.
+     * @param card The selected card on which to operate the new transaction.
+     * @return The current instance.
+     * @throw IllegalArgumentException If one of the parameters is null.
+     * @throw IllegalStateException If a secure session is open or if an asynchronous processing is
+     *        in progress (see {@link
+     *        #processCommandsAsync(ChannelControl, CardTransactionExecutor, std::function)}).
+     * @since 2.0.0
+     */
+    virtual T&
+    reset(const std::shared_ptr<CardReader> cardReader, const std::shared_ptr<CalypsoCard> card)
+        = 0;
+
+    /**
+     * Registers an observer notified of the progress of the transactions (commands preparation,
+     * APDU exchanges, cryptographic computations, secure session opening and closing).
+     *
+     * <p>No observer is registered by default, in which case the manager does not read the clock.
+     * The observer remains registered after a call to {@link #reset(std::shared_ptr,
+     * std::shared_ptr)}.
+     *
+     * @param observer The observer to register, or null to unregister the current one.
+     * @return The current instance.
+     * @throw IllegalStateException If an asynchronous processing is in progress (see {@link
+     *        #processCommandsAsync(ChannelControl, CardTransactionExecutor, std::function)}).
+     * @see CardTransactionObserver
+     * @since 2.0.0
+     */
+    virtual T& setTransactionObserver(const std::shared_ptr<CardTransactionObserver> observer) = 0;
+
+    /**
+     * Registers a sink to which each APDU exchange with the card or the cryptographic module is
+     * streamed as soon as it occurs.
+     *
+     * <p>The sink receives the exchanges independently of the retention policy of the audit data
+     * returned by {@link #getTransactionAuditData()} (see {@link
+     * #setTransactionAuditDataMaxSize(size_t)}). The sink remains registered after a call to
+     * {@link #reset(std::shared_ptr, std::shared_ptr)}.
+     *
+     * @param sink The sink to register, or null to unregister the current one.
+     * @return The current instance.
+     * @throw IllegalStateException If an asynchronous processing is in progress (see {@link
+     *        #processCommandsAsync(ChannelControl, CardTransactionExecutor, std::function)}).
+     * @see TransactionAuditSink
+     * @since 2.0.0
+     */
+    virtual T& setTransactionAuditSink(const std::shared_ptr<TransactionAuditSink> sink) = 0;
+
+    /**
+     * Sets the maximum number of bytes (commands and responses) retained in the audit data
+     * returned by {@link #getTransactionAuditData()}.
+     *
+     * <p>When the limit is exceeded, the oldest exchanges (command and response together) are
+     * discarded. A value of 0 disables the retention altogether, which is the recommended setting
+     * when a {@link TransactionAuditSink} is registered.
+     *
+     * <p>By default, the audit data is not limited.
+     *
+     * @param maxSize The maximum number of bytes to retain.
+     * @return The current instance.
+     * @throw IllegalStateException If an asynchronous processing is in progress (see {@link
+     *        #processCommandsAsync(ChannelControl, CardTransactionExecutor, std::function)}).
+     * @since 2.0.0
+     */
+    virtual T& setTransactionAuditDataMaxSize(const size_t maxSize) = 0;
 
     /**
      * Returns the audit data of the transaction containing all APDU exchanges with the card and the
      * cryptographic module.
      *
+     * <p>Only the most recent exchanges are available if a limit has been set with {@link
+     * #setTransactionAuditDataMaxSize(size_t)}.
+     *
      * @return An empty list if there is no audit data.
      * @since 1.2.0
      */
-    const st::vector<std::vector<uint8_t>>& getTransactionAuditData() const = 0;
+    virtual const std::vector<std::vector<uint8_t>>& getTransactionAuditData() const = 0;
 };
 
 } /* namespace transaction */
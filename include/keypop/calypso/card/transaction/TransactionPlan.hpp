@@ -0,0 +1,85 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <memory>
+
+#include "keypop/calypso/card/card/CalypsoCard.hpp"
+#include "keypop/reader/CardReader.hpp"
+
+namespace keypop {
+namespace calypso {
+namespace card {
+namespace transaction {
+
+using keypop::calypso::card::card::CalypsoCard;
+using keypop::reader::CardReader;
+
+/**
+ * Precompiled sequence of card commands, recorded once and replayed for each new card.
+ *
+ * <p>A plan captures the commands prepared on a reference transaction manager (e.g. "Open Secure
+ * Session", "Read Records", "Increase", "Close Secure Session"). The arguments of the commands are
+ * validated and the APDUs are built when the plan is created. Binding the plan to a new card only
+ * patches the fields that depend on the card (e.g. session keys, card serial number, transaction
+ * counter), which avoids repeating the validation and the construction of the command list at each
+ * transaction.
+ *
+ * <p>Commands whose APDU can only be completed during the processing (e.g. Stored Value
+ * operations or ciphered PIN operations) are completed at processing time as with a regular
+ * transaction manager.
+ *
+ * <p>A plan is immutable and can be bound concurrently from several threads.
+ *
+ * <p>An instance of this interface can be obtained via the methods {@code
+ * CalypsoCardApiFactory#createTransactionPlan(...)}.
+ *
+ * @param <T> The type of the transaction manager produced by the plan.
+ * @since 2.0.0
+ */
+template <typename T>
+class TransactionPlan {
+public:
+    /**
+     * Virtual destructor.
+     */
+    virtual ~TransactionPlan() = default;
+
+    /**
+     * Returns a new transaction manager operating on the provided card and reader, in which all the
+     * commands of the plan are already prepared.
+     *
+     * <p>Additional commands may be prepared on the returned manager before processing them.
+     *
+     * @param cardReader The card reader to be used.
+     * @param card The selected card on which to operate the transaction.
+     * @return A not null reference.
+     * @throw IllegalArgumentException If one of the parameters is null or if the card is not
+     *        compatible with the card used to record the plan (different product type or missing
+     *        feature required by one of the commands).
+     * @since 2.0.0
+     */
+    virtual std::shared_ptr<T>
+    bind(const std::shared_ptr<CardReader> cardReader, const std::shared_ptr<CalypsoCard> card)
+        = 0;
+
+    /**
+     * Gets the number of card commands contained in the plan.
+     *
+     * @return A positive value.
+     * @since 2.0.0
+     */
+    virtual int getCommandsCount() const = 0;
+};
+
+} /* namespace transaction */
+} /* namespace card */
+} /* namespace calypso */
+} /* namespace keypop */
@@ -0,0 +1,56 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <functional>
+
+namespace keypop {
+namespace calypso {
+namespace card {
+namespace transaction {
+namespace spi {
+
+/**
+ * SPI provided by the application to run the steps of an asynchronous card transaction.
+ *
+ * <p>The transaction manager splits the processing of the prepared commands into successive steps,
+ * each performing at most one card exchange, and submits each step to the executor. The
+ * application is free to run the steps on a thread pool, on an event loop, or inline.
+ *
+ * <p>The steps of a given transaction are always submitted one after the other: a step is only
+ * submitted once the previous one has completed.
+ *
+ * @see TransactionManager#processCommandsAsync(ChannelControl, CardTransactionExecutor,
+ *      std::function)
+ * @since 2.0.0
+ */
+class CardTransactionExecutor {
+public:
+    /**
+     * Virtual destructor
+     */
+    virtual ~CardTransactionExecutor() = default;
+
+    /**
+     * Schedules the execution of a transaction step.
+     *
+     * <p>This method must not block the calling thread waiting for the task to complete.
+     *
+     * @param task The task to run (never empty).
+     * @since 2.0.0
+     */
+    virtual void execute(const std::function<void()>& task) = 0;
+};
+
+} /* namespace spi */
+} /* namespace transaction */
+} /* namespace card */
+} /* namespace calypso */
+} /* namespace keypop */
@@ -0,0 +1,138 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <string>
+
+#include "keypop/calypso/card/ArrayView.hpp"
+
+namespace keypop {
+namespace calypso {
+namespace card {
+namespace transaction {
+namespace spi {
+
+using keypop::calypso::card::ByteArrayView;
+
+/**
+ * SPI provided by the application to be notified of the progress of a card transaction, for
+ * instrumentation purposes (e.g. per-phase latency histograms).
+ *
+ * <p>Each notification carries the monotonic time at which the corresponding event occurred, so
+ * that the elapsed time between two events (card I/O, cryptographic computation, library
+ * processing) can be computed without the observer reading the clock itself.
+ *
+ * <p>The methods are invoked synchronously by the transaction manager, from the thread running the
+ * processing (or the "prepare" method). They must return quickly and must not call the transaction
+ * manager. Exceptions thrown by the observer are caught and ignored by the transaction manager.
+ *
+ * <p>The views provided as arguments are only valid during the call.
+ *
+ * @see TransactionManager#setTransactionObserver(std::shared_ptr)
+ * @since 2.0.0
+ */
+class CardTransactionObserver {
+public:
+    /**
+     * Monotonic time point used for all notifications.
+     *
+     * @since 2.0.0
+     */
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    /**
+     * Virtual destructor
+     */
+    virtual ~CardTransactionObserver() = default;
+
+    /**
+     * Invoked when a card command has been prepared.
+     *
+     * @param timestamp The time of the event.
+     * @param commandName The name of the card command (e.g. "READ RECORD").
+     * @since 2.0.0
+     */
+    virtual void onCommandPrepared(const TimePoint timestamp, const std::string& commandName) = 0;
+
+    /**
+     * Invoked when the processing of the prepared commands starts.
+     *
+     * @param timestamp The time of the event.
+     * @since 2.0.0
+     */
+    virtual void onProcessingStarted(const TimePoint timestamp) = 0;
+
+    /**
+     * Invoked when the processing of the prepared commands ends, whether it succeeded or not.
+     *
+     * @param timestamp The time of the event.
+     * @since 2.0.0
+     */
+    virtual void onProcessingEnded(const TimePoint timestamp) = 0;
+
+    /**
+     * Invoked just before an APDU is transmitted to the card.
+     *
+     * @param timestamp The time of the event.
+     * @param apdu The command APDU.
+     * @since 2.0.0
+     */
+    virtual void onApduSent(const TimePoint timestamp, const ByteArrayView apdu) = 0;
+
+    /**
+     * Invoked just after the response to an APDU has been received from the card.
+     *
+     * @param timestamp The time of the event.
+     * @param apdu The response APDU, including the status word.
+     * @since 2.0.0
+     */
+    virtual void onApduReceived(const TimePoint timestamp, const ByteArrayView apdu) = 0;
+
+    /**
+     * Invoked just before a call to the cryptographic extension (e.g. SAM command, signature
+     * computation or verification).
+     *
+     * @param timestamp The time of the event.
+     * @since 2.0.0
+     */
+    virtual void onCryptoStarted(const TimePoint timestamp) = 0;
+
+    /**
+     * Invoked just after a call to the cryptographic extension, whether it succeeded or not.
+     *
+     * @param timestamp The time of the event.
+     * @since 2.0.0
+     */
+    virtual void onCryptoEnded(const TimePoint timestamp) = 0;
+
+    /**
+     * Invoked when a secure session has been opened by the card.
+     *
+     * @param timestamp The time of the event.
+     * @since 2.0.0
+     */
+    virtual void onSessionOpened(const TimePoint timestamp) = 0;
+
+    /**
+     * Invoked when a secure session has been closed or cancelled.
+     *
+     * @param timestamp The time of the event.
+     * @param cancelled True if the session has been cancelled (all modifications are discarded).
+     * @since 2.0.0
+     */
+    virtual void onSessionClosed(const TimePoint timestamp, const bool cancelled) = 0;
+};
+
+} /* namespace spi */
+} /* namespace transaction */
+} /* namespace card */
+} /* namespace calypso */
+} /* namespace keypop */
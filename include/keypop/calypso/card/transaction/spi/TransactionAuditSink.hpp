@@ -0,0 +1,84 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include "keypop/calypso/card/ArrayView.hpp"
+
+namespace keypop {
+namespace calypso {
+namespace card {
+namespace transaction {
+namespace spi {
+
+using keypop::calypso::card::ByteArrayView;
+
+/**
+ * SPI provided by the application to receive the transaction audit data as it is produced.
+ *
+ * <p>Each APDU exchanged with the card or with the cryptographic module is streamed to the sink
+ * as soon as its response is received, allowing the application to write it to a ring buffer, a
+ * file or any other storage of its choice, at a constant cost per exchange.
+ *
+ * <p>The method is invoked synchronously by the transaction manager, from the thread running the
+ * processing. It must return quickly and must not call the transaction manager.
+ *
+ * <p>The views provided as arguments are only valid during the call: the sink must copy the data
+ * it wants to keep.
+ *
+ * @see TransactionManager#setTransactionAuditSink(std::shared_ptr)
+ * @since 2.0.0
+ */
+class TransactionAuditSink {
+public:
+    /**
+     * Origin of an APDU exchange.
+     *
+     * @since 2.0.0
+     */
+    enum class Source {
+        /**
+         * Exchange with the card.
+         *
+         * @since 2.0.0
+         */
+        CARD,
+
+        /**
+         * Exchange with the cryptographic module (e.g. SAM).
+         *
+         * @since 2.0.0
+         */
+        CRYPTO_MODULE
+    };
+
+    /**
+     * Virtual destructor
+     */
+    virtual ~TransactionAuditSink() = default;
+
+    /**
+     * Invoked after each APDU exchange.
+     *
+     * @param source The origin of the exchange.
+     * @param command The command APDU.
+     * @param response The response APDU, including the status word (empty if no response has been
+     *        received).
+     * @since 2.0.0
+     */
+    virtual void onApduExchange(
+        const Source source, const ByteArrayView command, const ByteArrayView response)
+        = 0;
+};
+
+} /* namespace spi */
+} /* namespace transaction */
+} /* namespace card */
+} /* namespace calypso */
+} /* namespace keypop */
@@ -0,0 +1,239 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <cstdint>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+/* Benchmark */
+#include "ReferenceCardFactory.hpp"
+
+using keypop::calypso::card::card::FileData;
+
+static void
+BM_CalypsoCard_getAllFiles_lookupBySfi(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+
+    for (auto _ : state) {
+        const auto files = card->getAllFiles();
+        const uint8_t sfi = ReferenceCardFactory::COUNTER_SFI;
+        benchmark::DoNotOptimize(files.find(sfi)->second.get());
+    }
+}
+BENCHMARK(BM_CalypsoCard_getAllFiles_lookupBySfi);
+
+static void
+BM_CalypsoCard_getFileBySfi(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(card->getFileBySfi(ReferenceCardFactory::COUNTER_SFI));
+    }
+}
+BENCHMARK(BM_CalypsoCard_getFileBySfi);
+
+static void
+BM_CalypsoCard_getFileBySfiPtr(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(card->getFileBySfiPtr(ReferenceCardFactory::COUNTER_SFI));
+    }
+}
+BENCHMARK(BM_CalypsoCard_getFileBySfiPtr);
+
+static void
+BM_CalypsoCard_getSfiIndex(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(card->getSfiIndex()[ReferenceCardFactory::COUNTER_SFI].get());
+    }
+}
+BENCHMARK(BM_CalypsoCard_getSfiIndex);
+
+static void
+BM_CalypsoCard_getFileByLid(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(card->getFileByLidPtr(0x2069));
+    }
+}
+BENCHMARK(BM_CalypsoCard_getFileByLid);
+
+static void
+BM_FileData_getAllCountersValue(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+    const FileData* data
+        = card->getFileBySfiPtr(ReferenceCardFactory::COUNTER_SFI)->getDataPtr();
+
+    for (auto _ : state) {
+        int sum = 0;
+        for (const auto& entry : data->getAllCountersValue()) {
+            sum += entry.second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_FileData_getAllCountersValue);
+
+static void
+BM_FileData_getCounterValues(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+    const FileData* data
+        = card->getFileBySfiPtr(ReferenceCardFactory::COUNTER_SFI)->getDataPtr();
+
+    for (auto _ : state) {
+        const auto& counterValues = data->getCounterValues();
+        int sum = 0;
+        for (size_t i = 0; i < counterValues.getCount(); i++) {
+            sum += counterValues.getValues()[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_FileData_getCounterValues);
+
+static void
+BM_FileData_getContent(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+    const FileData* data = card->getFileBySfiPtr(1)->getDataPtr();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(data->getContent(2, 4, 8));
+    }
+}
+BENCHMARK(BM_FileData_getContent);
+
+static void
+BM_FileData_getContentView(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+    const FileData* data = card->getFileBySfiPtr(1)->getDataPtr();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(data->getContentView(2, 4, 8).data());
+    }
+}
+BENCHMARK(BM_FileData_getContentView);
+
+static void
+BM_CalypsoCard_walkFiles(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+
+    for (auto _ : state) {
+        size_t sum = 0;
+        for (const auto& ef : card->getFiles()) {
+            for (const auto& record : ef->getDataPtr()->getAllRecordsContent()) {
+                sum += record.second[0];
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_CalypsoCard_walkFiles);
+
+static void
+BM_CardImage_walkRecords(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+
+    for (auto _ : state) {
+        const CardImage& image = card->getCardImage();
+        size_t sum = 0;
+        for (const CardImage::Record& record : image.getRecords()) {
+            sum += image.getContent(record)[0];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_CardImage_walkRecords);
+
+static void
+BM_CardImage_copy(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+
+    for (auto _ : state) {
+        const CardImage copy = card->getCardImage();
+        benchmark::DoNotOptimize(copy.getArena().data());
+    }
+    state.SetBytesProcessed(
+        state.iterations() * static_cast<int64_t>(card->getCardImage().getArena().size()));
+}
+BENCHMARK(BM_CardImage_copy);
+
+static void
+BM_CalypsoCard_exportSnapshot(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+    std::vector<uint8_t> snapshot;
+
+    for (auto _ : state) {
+        snapshot.clear();
+        card->exportSnapshot(snapshot);
+        benchmark::DoNotOptimize(snapshot.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(snapshot.size()));
+}
+BENCHMARK(BM_CalypsoCard_exportSnapshot);
+
+static void
+BM_CardImage_deserialize(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+    std::vector<uint8_t> serialized;
+    card->getCardImage().serialize(serialized);
+    CardImage image;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(image.deserialize(serialized));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(serialized.size()));
+}
+BENCHMARK(BM_CardImage_deserialize);
+
+static void
+BM_CalypsoCard_restoreSnapshot(benchmark::State& state) {
+    std::vector<uint8_t> snapshot;
+    ReferenceCardFactory::createCard()->exportSnapshot(snapshot);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ReferenceCalypsoCard::restore(snapshot).get());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(snapshot.size()));
+}
+BENCHMARK(BM_CalypsoCard_restoreSnapshot);
+
+static void
+BM_SvLogRecords_decode(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+
+    for (auto _ : state) {
+        int sum = card->getSvLoadLogRecord()->getAmount();
+        for (const auto& debitLog : card->getSvDebitLogAllRecords()) {
+            sum += debitLog->getAmount() + debitLog->getBalance() + debitLog->getSvTNum();
+            benchmark::DoNotOptimize(debitLog->getSamId());
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_SvLogRecords_decode);
+
+static void
+BM_SvLogEntries_read(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+
+    for (auto _ : state) {
+        int sum = card->getSvLoadLogEntry()->amount;
+        for (const SvDebitLogEntry& debitLog : card->getSvDebitLogEntries()) {
+            sum += debitLog.amount + debitLog.balance + debitLog.svTNum;
+            benchmark::DoNotOptimize(debitLog.samId.data());
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_SvLogEntries_read);
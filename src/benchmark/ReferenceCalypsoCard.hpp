@@ -0,0 +1,650 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* Keypop Calypso Card */
+#include "keypop/calypso/card/card/CalypsoCard.hpp"
+#include "keypop/calypso/card/card/CardSnapshot.hpp"
+
+/* Benchmark */
+#include "ReferenceDirectoryHeader.hpp"
+#include "ReferenceElementaryFile.hpp"
+#include "ReferenceSvDebitLogRecord.hpp"
+#include "ReferenceSvLoadLogRecord.hpp"
+
+using keypop::calypso::card::ByteArrayView;
+using keypop::calypso::card::card::CalypsoCard;
+using keypop::calypso::card::card::CardChange;
+using keypop::calypso::card::card::CardImage;
+using keypop::calypso::card::card::CardSnapshot;
+using keypop::calypso::card::card::DirectoryHeader;
+using keypop::calypso::card::card::ElementaryFile;
+using keypop::calypso::card::card::FileKey;
+using keypop::calypso::card::card::SvDebitLogEntry;
+using keypop::calypso::card::card::SvDebitLogRecord;
+using keypop::calypso::card::card::SvLoadLogEntry;
+using keypop::calypso::card::card::SvLoadLogRecord;
+
+/**
+ * In-memory reference implementation of CalypsoCard.
+ *
+ * <p>The card image is filled directly by the benchmarks or by the reference transaction manager,
+ * without any APDU exchange.
+ */
+class ReferenceCalypsoCard final : public CalypsoCard {
+public:
+    ReferenceCalypsoCard()
+    : mPowerOnData("3B8F8001804F0CA000000306030001000000006A")
+    , mSelectApplicationResponse({0x6F, 0x00, 0x90, 0x00})
+    , mDfName({0x31, 0x54, 0x49, 0x43, 0x2E, 0x49, 0x43, 0x41})
+    , mApplicationSerialNumber({0x00, 0x00, 0x00, 0x00, 0x11, 0x22, 0x33, 0x44})
+    , mStartupInfo({0x0A, 0x3C, 0x20, 0x05, 0x14, 0x10, 0x01})
+    , mFlags(
+          CardSnapshot::FLAG_DF_RATIFIED | CardSnapshot::FLAG_EXTENDED_MODE
+          | CardSnapshot::FLAG_RATIFICATION_ON_DESELECT | CardSnapshot::FLAG_SV_FEATURE)
+    , mSfiIndex()
+    , mTransactionCounter(0)
+    , mTransactionCounterKnown(false)
+    , mPinAttemptRemaining(-1)
+    , mSvDataKnown(false)
+    , mSvBalance(0)
+    , mSvLastTNum(0) {
+    }
+
+    /* SmartCard / IsoSmartCard */
+
+    const std::string&
+    getPowerOnData() const override {
+        return mPowerOnData;
+    }
+
+    const std::vector<uint8_t>&
+    getSelectApplicationResponse() const override {
+        return mSelectApplicationResponse;
+    }
+
+    /* CalypsoCard */
+
+    const ProductType&
+    getProductType() const override {
+        return mProductType;
+    }
+
+    bool
+    isHce() const override {
+        return (mFlags & CardSnapshot::FLAG_HCE) != 0;
+    }
+
+    bool
+    isDfInvalidated() const override {
+        return (mFlags & CardSnapshot::FLAG_DF_INVALIDATED) != 0;
+    }
+
+    const std::vector<uint8_t>&
+    getDfName() const override {
+        return mDfName;
+    }
+
+    const std::vector<uint8_t>
+    getApplicationSerialNumber() const override {
+        return mApplicationSerialNumber;
+    }
+
+    const std::vector<uint8_t>&
+    getStartupInfoRawData() const override {
+        return mStartupInfo;
+    }
+
+    uint8_t
+    getPlatform() const override {
+        return mStartupInfo[2];
+    }
+
+    uint8_t
+    getApplicationType() const override {
+        return mStartupInfo[3];
+    }
+
+    uint8_t
+    getApplicationSubtype() const override {
+        return mStartupInfo[4];
+    }
+
+    uint8_t
+    getSoftwareIssuer() const override {
+        return mStartupInfo[5];
+    }
+
+    uint8_t
+    getSoftwareVersion() const override {
+        return mStartupInfo[6];
+    }
+
+    uint8_t
+    getSoftwareRevision() const override {
+        return 0x00;
+    }
+
+    uint8_t
+    getSessionModification() const override {
+        return mStartupInfo[1];
+    }
+
+    const std::vector<uint8_t>
+    getTraceabilityInformation() const override {
+        return mTraceabilityInformation;
+    }
+
+    const std::shared_ptr<DirectoryHeader>
+    getDirectoryHeader() const override {
+        return mDirectoryHeader;
+    }
+
+    const DirectoryHeader*
+    getDirectoryHeaderPtr() const override {
+        return mDirectoryHeader.get();
+    }
+
+    const std::shared_ptr<ElementaryFile>
+    getFileBySfi(const uint8_t sfi) const override {
+        return sfi < SFI_INDEX_SIZE ? mSfiIndex[sfi] : nullptr;
+    }
+
+    const ElementaryFile*
+    getFileBySfiPtr(const uint8_t sfi) const override {
+        return sfi < SFI_INDEX_SIZE ? mSfiIndex[sfi].get() : nullptr;
+    }
+
+    const std::shared_ptr<ElementaryFile>
+    getFileByLid(const uint16_t lid) const override {
+        const auto it = findLid(lid);
+        return it != mLidIndex.end() ? it->second : nullptr;
+    }
+
+    const ElementaryFile*
+    getFileByLidPtr(const uint16_t lid) const override {
+        const auto it = findLid(lid);
+        return it != mLidIndex.end() ? it->second.get() : nullptr;
+    }
+
+    const SfiIndex&
+    getSfiIndex() const override {
+        return mSfiIndex;
+    }
+
+    const LidIndex&
+    getLidIndex() const override {
+        return mLidIndex;
+    }
+
+    const std::map<const uint8_t, const std::shared_ptr<ElementaryFile>>
+    getAllFiles() const override {
+        std::map<const uint8_t, const std::shared_ptr<ElementaryFile>> result;
+        for (const auto& ef : mFiles) {
+            if (ef->getSfi() != 0) {
+                result.insert({ef->getSfi(), ef});
+            }
+        }
+
+        return result;
+    }
+
+    const std::vector<std::shared_ptr<ElementaryFile>>&
+    getFiles() const override {
+        return mFiles;
+    }
+
+    /**
+     * The reference implementation maintains the image as its store: each modification of a file
+     * or of the SV data is written to it, so that this getter only returns a reference and never
+     * modifies the card.
+     */
+    const CardImage&
+    getCardImage() const override {
+        return mCardImage;
+    }
+
+    /**
+     * The reference snapshot is the serialized form of a CardSnapshot holding every field of the
+     * card, including the identification data and all the DF and EF headers.
+     */
+    void
+    exportSnapshot(std::vector<uint8_t>& snapshot) const override {
+        CardSnapshot data;
+        data.powerOnData = mPowerOnData;
+        data.selectApplicationResponse = mSelectApplicationResponse;
+        data.productType = static_cast<uint8_t>(mProductType);
+        data.dfName = mDfName;
+        data.applicationSerialNumber = mApplicationSerialNumber;
+        data.startupInfo = mStartupInfo;
+        data.traceabilityInformation = mTraceabilityInformation;
+        data.flags = mFlags;
+
+        if (mDirectoryHeader) {
+            data.hasDfHeader = true;
+            data.dfHeader.lid = mDirectoryHeader->getLid();
+            data.dfHeader.dfStatus = mDirectoryHeader->getDfStatus();
+            data.dfHeader.accessConditions = mDirectoryHeader->getAccessConditions();
+            data.dfHeader.keyIndexes = mDirectoryHeader->getKeyIndexes();
+            const WriteAccessLevel levels[] = {
+                WriteAccessLevel::PERSONALIZATION, WriteAccessLevel::LOAD, WriteAccessLevel::DEBIT};
+            for (size_t i = 0; i < 3; i++) {
+                data.dfHeader.kifs[i] = mDirectoryHeader->getKif(levels[i]);
+                data.dfHeader.kvcs[i] = mDirectoryHeader->getKvc(levels[i]);
+            }
+        }
+
+        for (const auto& ef : mFiles) {
+            const FileHeader* header = ef->getHeaderPtr();
+            if (header != nullptr) {
+                const Optional<uint8_t> dfStatus = header->getOptionalDfStatus();
+                const Optional<uint16_t> sharedReference = header->getOptionalSharedReference();
+                CardSnapshot::EfHeader efHeader;
+                efHeader.sfi = ef->getSfi();
+                efHeader.lid = header->getLid();
+                efHeader.efType = header->getEfType();
+                efHeader.recordsNumber = static_cast<uint16_t>(header->getRecordsNumber());
+                efHeader.recordSize = static_cast<uint16_t>(header->getRecordSize());
+                efHeader.accessConditions = header->getAccessConditions();
+                efHeader.keyIndexes = header->getKeyIndexes();
+                efHeader.presence = static_cast<uint8_t>(
+                    (dfStatus.isPresent() ? CardSnapshot::HEADER_DF_STATUS : 0)
+                    | (sharedReference.isPresent() ? CardSnapshot::HEADER_SHARED_REFERENCE : 0));
+                efHeader.dfStatus = dfStatus.orElse(0);
+                efHeader.sharedReference = sharedReference.orElse(0);
+                data.efHeaders.push_back(efHeader);
+            }
+        }
+
+        data.sessionData = static_cast<uint8_t>(
+            (mTransactionCounterKnown ? CardSnapshot::SESSION_TRANSACTION_COUNTER : 0)
+            | (mPinAttemptRemaining >= 0 ? CardSnapshot::SESSION_PIN_ATTEMPTS : 0)
+            | (mSvDataKnown ? CardSnapshot::SESSION_SV_DATA : 0));
+        data.transactionCounter = mTransactionCounter;
+        data.pinAttemptRemaining = mPinAttemptRemaining;
+        data.svBalance = mSvBalance;
+        data.svLastTNum = mSvLastTNum;
+        data.cardImage = mCardImage;
+
+        data.serialize(snapshot);
+    }
+
+    /**
+     * Creates a card from a snapshot produced by exportSnapshot().
+     */
+    static std::shared_ptr<ReferenceCalypsoCard>
+    restore(const ByteArrayView snapshot) {
+        CardSnapshot data;
+        data.deserialize(snapshot);
+        if (data.productType > static_cast<uint8_t>(ProductType::UNKNOWN)
+            || data.startupInfo.size() < 7) {
+            throw std::invalid_argument("Malformed snapshot");
+        }
+
+        const auto card = std::make_shared<ReferenceCalypsoCard>();
+        card->mPowerOnData = data.powerOnData;
+        card->mSelectApplicationResponse = data.selectApplicationResponse;
+        card->mProductType = static_cast<ProductType>(data.productType);
+        card->mDfName = data.dfName;
+        card->mApplicationSerialNumber = data.applicationSerialNumber;
+        card->mStartupInfo = data.startupInfo;
+        card->mTraceabilityInformation = data.traceabilityInformation;
+        card->mFlags = data.flags;
+
+        if (data.hasDfHeader) {
+            card->mDirectoryHeader = std::make_shared<ReferenceDirectoryHeader>(
+                data.dfHeader.lid,
+                data.dfHeader.dfStatus,
+                data.dfHeader.accessConditions,
+                data.dfHeader.keyIndexes,
+                data.dfHeader.kifs,
+                data.dfHeader.kvcs);
+        }
+
+        for (const CardSnapshot::EfHeader& header : data.efHeaders) {
+            card->setFileHeader(
+                header.sfi,
+                std::make_shared<ReferenceFileHeader>(
+                    header.lid,
+                    header.efType,
+                    header.recordsNumber,
+                    header.recordSize,
+                    header.accessConditions,
+                    header.keyIndexes,
+                    (header.presence & CardSnapshot::HEADER_DF_STATUS) != 0
+                        ? std::make_shared<uint8_t>(header.dfStatus)
+                        : nullptr,
+                    (header.presence & CardSnapshot::HEADER_SHARED_REFERENCE) != 0
+                        ? std::make_shared<uint16_t>(header.sharedReference)
+                        : nullptr));
+        }
+
+        if ((data.sessionData & CardSnapshot::SESSION_TRANSACTION_COUNTER) != 0) {
+            card->setTransactionCounter(data.transactionCounter);
+        }
+        if ((data.sessionData & CardSnapshot::SESSION_PIN_ATTEMPTS) != 0) {
+            card->mPinAttemptRemaining = data.pinAttemptRemaining;
+        }
+        if ((data.sessionData & CardSnapshot::SESSION_SV_DATA) != 0) {
+            card->mSvDataKnown = true;
+            card->mSvBalance = data.svBalance;
+            card->mSvLastTNum = data.svLastTNum;
+        }
+
+        const CardImage& image = data.cardImage;
+        card->mCardImage.reserve(image.getArena().size(), image.getRecords().size());
+        std::vector<uint8_t> loadLog;
+        std::vector<std::vector<uint8_t>> debitLogs;
+        for (const CardImage::Record& record : image.getRecords()) {
+            const std::vector<uint8_t> content = image.getContent(record).toVector();
+            switch (record.file.getSpace()) {
+            case FileKey::Space::SFI:
+                card->getOrCreateFile(static_cast<uint8_t>(record.file.getId()))
+                    .getMutableData()
+                    .setContent(record.number, content);
+                break;
+            case FileKey::Space::LID:
+                card->getOrCreateFileByLid(record.file.getId())
+                    .getMutableData()
+                    .setContent(record.number, content);
+                break;
+            case FileKey::Space::SV_LOG:
+                if (record.file == FileKey::svLoadLog()) {
+                    loadLog = content;
+                } else {
+                    debitLogs.push_back(content);
+                }
+                break;
+            }
+        }
+
+        if (!loadLog.empty()) {
+            card->setSvData(card->mSvBalance, card->mSvLastTNum, loadLog, debitLogs);
+        }
+
+        /* The setters above mark every record complete: keep the known ranges of the snapshot */
+        card->mCardImage = image;
+
+        return card;
+    }
+
+    const std::vector<CardChange>&
+    getChanges() const override {
+        return mChanges;
+    }
+
+    bool
+    isDfRatified() const override {
+        return (mFlags & CardSnapshot::FLAG_DF_RATIFIED) != 0;
+    }
+
+    int
+    getTransactionCounter() const override {
+        return mTransactionCounter;
+    }
+
+    bool
+    isPkiModeSupported() const override {
+        return (mFlags & CardSnapshot::FLAG_PKI_MODE) != 0;
+    }
+
+    bool
+    isExtendedModeSupported() const override {
+        return (mFlags & CardSnapshot::FLAG_EXTENDED_MODE) != 0;
+    }
+
+    bool
+    isRatificationOnDeselectSupported() const override {
+        return (mFlags & CardSnapshot::FLAG_RATIFICATION_ON_DESELECT) != 0;
+    }
+
+    bool
+    isPinFeatureAvailable() const override {
+        return (mFlags & CardSnapshot::FLAG_PIN_FEATURE) != 0;
+    }
+
+    bool
+    isPinBlocked() const override {
+        return getPinAttemptRemaining() == 0;
+    }
+
+    int
+    getPinAttemptRemaining() const override {
+        if (mPinAttemptRemaining < 0) {
+            throw std::logic_error("PIN status not checked");
+        }
+
+        return mPinAttemptRemaining;
+    }
+
+    bool
+    isSvFeatureAvailable() const override {
+        return (mFlags & CardSnapshot::FLAG_SV_FEATURE) != 0;
+    }
+
+    int
+    getSvBalance() const override {
+        return mSvBalance;
+    }
+
+    int
+    getSvLastTNum() const override {
+        return mSvLastTNum;
+    }
+
+    const std::shared_ptr<SvLoadLogRecord>
+    getSvLoadLogRecord() override {
+        return mSvLoadLogRecord;
+    }
+
+    const std::shared_ptr<SvDebitLogRecord>
+    getSvDebitLogLastRecord() override {
+        return mSvDebitLogRecords.empty() ? nullptr : mSvDebitLogRecords.front();
+    }
+
+    const std::vector<std::shared_ptr<SvDebitLogRecord>>
+    getSvDebitLogAllRecords() const override {
+        return mSvDebitLogRecords;
+    }
+
+    const SvLoadLogEntry*
+    getSvLoadLogEntry() const override {
+        return mSvLoadLogRecord ? &mSvLoadLogEntry : nullptr;
+    }
+
+    const std::vector<SvDebitLogEntry>&
+    getSvDebitLogEntries() const override {
+        return mSvDebitLogEntries;
+    }
+
+    /* Card image management */
+
+    /**
+     * Gets the file having the provided SFI, creating it if needed.
+     *
+     * <p>The SFI must be in [1..30]: SFI 0, which designates the current EF in the commands, has
+     * to be resolved by the caller (see ReferenceTransactionManager).
+     */
+    ReferenceElementaryFile&
+    getOrCreateFile(const uint8_t sfi) {
+        if (sfi == 0 || sfi >= SFI_INDEX_SIZE) {
+            throw std::invalid_argument("sfi");
+        }
+
+        if (!mSfiIndex[sfi]) {
+            const auto ef =
+                std::make_shared<ReferenceElementaryFile>(sfi, mCardImage, FileKey::ofSfi(sfi));
+            mSfiIndex[sfi] = ef;
+            mFiles.push_back(ef);
+        }
+
+        return static_cast<ReferenceElementaryFile&>(*mSfiIndex[sfi]);
+    }
+
+    /**
+     * Gets the file having the provided LID, creating it as a file without SFI if needed.
+     */
+    ReferenceElementaryFile&
+    getOrCreateFileByLid(const uint16_t lid) {
+        const auto it = findLid(lid);
+        if (it != mLidIndex.end()) {
+            return static_cast<ReferenceElementaryFile&>(*it->second);
+        }
+
+        const auto ef =
+            std::make_shared<ReferenceElementaryFile>(0, mCardImage, FileKey::ofLid(lid));
+        mFiles.push_back(ef);
+        registerLid(lid, ef);
+
+        return *ef;
+    }
+
+    /**
+     * Sets the header of a file and registers its LID. A zero SFI designates a file without SFI.
+     */
+    void
+    setFileHeader(const uint8_t sfi, const std::shared_ptr<ReferenceFileHeader> header) {
+        if (sfi == 0) {
+            getOrCreateFileByLid(header->getLid()).setHeader(header);
+            return;
+        }
+
+        getOrCreateFile(sfi).setHeader(header);
+        registerLid(header->getLid(), mSfiIndex[sfi]);
+    }
+
+    /**
+     * Sets the SV data and logs.
+     */
+    void
+    setSvData(
+        const int balance,
+        const int lastTNum,
+        const std::vector<uint8_t>& loadLog,
+        const std::vector<std::vector<uint8_t>>& debitLogs) {
+        mSvDataKnown = true;
+        mSvBalance = balance;
+        mSvLastTNum = lastTNum;
+        mSvLoadLogRecord = std::make_shared<ReferenceSvLoadLogRecord>(loadLog);
+        mSvLoadLogEntry = SvLoadLogEntry::decode(loadLog);
+        mCardImage.setContent(FileKey::svLoadLog(), 1, loadLog);
+
+        for (size_t i = debitLogs.size(); i < mSvDebitLogRecords.size(); i++) {
+            mCardImage.removeContent(FileKey::svDebitLog(), static_cast<uint8_t>(i + 1));
+        }
+        mSvDebitLogRecords.clear();
+        mSvDebitLogEntries.clear();
+        for (const auto& debitLog : debitLogs) {
+            mSvDebitLogRecords.push_back(std::make_shared<ReferenceSvDebitLogRecord>(debitLog));
+            mSvDebitLogEntries.push_back(SvDebitLogEntry::decode(debitLog));
+            mCardImage.setContent(
+                FileKey::svDebitLog(),
+                static_cast<uint8_t>(mSvDebitLogRecords.size()),
+                debitLog);
+        }
+    }
+
+    /**
+     * Indicates whether the transaction counter has been set (pre-open at selection or session
+     * opening).
+     */
+    bool
+    isTransactionCounterKnown() const {
+        return mTransactionCounterKnown;
+    }
+
+    /**
+     * Sets the transaction counter.
+     */
+    void
+    setTransactionCounter(const int transactionCounter) {
+        mTransactionCounter = transactionCounter;
+        mTransactionCounterKnown = true;
+    }
+
+    /**
+     * Appends an entry to the change journal.
+     */
+    void
+    addChange(const CardChange& change) {
+        mChanges.push_back(change);
+    }
+
+    /**
+     * Clears the change journal (the capacity is kept to avoid further allocations).
+     */
+    void
+    clearChanges() {
+        mChanges.clear();
+    }
+
+private:
+    void
+    registerLid(const uint16_t lid, const std::shared_ptr<ElementaryFile> ef) {
+        const auto it = std::lower_bound(
+            mLidIndex.begin(),
+            mLidIndex.end(),
+            lid,
+            [](const LidIndex::value_type& entry, const uint16_t value) {
+                return entry.first < value;
+            });
+        if (it != mLidIndex.end() && it->first == lid) {
+            it->second = ef;
+        } else {
+            mLidIndex.insert(it, {lid, ef});
+        }
+    }
+
+    LidIndex::const_iterator
+    findLid(const uint16_t lid) const {
+        const auto it = std::lower_bound(
+            mLidIndex.begin(),
+            mLidIndex.end(),
+            lid,
+            [](const LidIndex::value_type& entry, const uint16_t value) {
+                return entry.first < value;
+            });
+        return it != mLidIndex.end() && it->first == lid ? it : mLidIndex.end();
+    }
+
+    ProductType mProductType = ProductType::PRIME_REVISION_3;
+    std::string mPowerOnData;
+    std::vector<uint8_t> mSelectApplicationResponse;
+    std::vector<uint8_t> mDfName;
+    std::vector<uint8_t> mApplicationSerialNumber;
+    std::vector<uint8_t> mStartupInfo;
+    std::vector<uint8_t> mTraceabilityInformation;
+    uint8_t mFlags;
+    std::shared_ptr<DirectoryHeader> mDirectoryHeader;
+    std::vector<std::shared_ptr<ElementaryFile>> mFiles;
+    SfiIndex mSfiIndex;
+    LidIndex mLidIndex;
+    std::vector<CardChange> mChanges;
+    CardImage mCardImage;
+    int mTransactionCounter;
+    bool mTransactionCounterKnown;
+    int mPinAttemptRemaining;
+    bool mSvDataKnown;
+    int mSvBalance;
+    int mSvLastTNum;
+    std::shared_ptr<SvLoadLogRecord> mSvLoadLogRecord;
+    std::vector<std::shared_ptr<SvDebitLogRecord>> mSvDebitLogRecords;
+    SvLoadLogEntry mSvLoadLogEntry;
+    std::vector<SvDebitLogEntry> mSvDebitLogEntries;
+};
@@ -0,0 +1,77 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/* Benchmark */
+#include "ReferenceCalypsoCard.hpp"
+
+/**
+ * Builds reference card images shared by the benchmarks.
+ */
+class ReferenceCardFactory final {
+public:
+    /**
+     * Number of linear files created by createCard().
+     */
+    static const int LINEAR_FILES_COUNT = 20;
+
+    /**
+     * SFI of the counter file created by createCard().
+     */
+    static const uint8_t COUNTER_SFI = 0x19;
+
+    /**
+     * Number of counters of the counter file created by createCard().
+     */
+    static const int COUNTERS_COUNT = 9;
+
+    /**
+     * Creates a card image having LINEAR_FILES_COUNT linear files of 4 records of 29 bytes, a
+     * counter file and SV logs (1 load log, 3 debit logs).
+     */
+    static std::shared_ptr<ReferenceCalypsoCard>
+    createCard() {
+        const auto card = std::make_shared<ReferenceCalypsoCard>();
+
+        for (int i = 0; i < LINEAR_FILES_COUNT; i++) {
+            const uint8_t sfi = static_cast<uint8_t>(i + 1);
+            card->setFileHeader(
+                sfi,
+                std::make_shared<ReferenceFileHeader>(
+                    static_cast<uint16_t>(0x2000 + sfi), ElementaryFile::Type::LINEAR, 4, 29));
+            ReferenceFileData& data = card->getOrCreateFile(sfi).getMutableData();
+            for (uint8_t record = 1; record <= 4; record++) {
+                data.setContent(record, std::vector<uint8_t>(29, static_cast<uint8_t>(record)));
+            }
+        }
+
+        card->setFileHeader(
+            COUNTER_SFI,
+            std::make_shared<ReferenceFileHeader>(0x2069, ElementaryFile::Type::COUNTERS, 1, 27));
+        ReferenceFileData& counters = card->getOrCreateFile(COUNTER_SFI).getMutableData();
+        for (int i = 1; i <= COUNTERS_COUNT; i++) {
+            counters.setCounter(i, i * 100);
+        }
+
+        card->setSvData(
+            1000,
+            12,
+            std::vector<uint8_t>(22, 0x11),
+            {std::vector<uint8_t>(19, 0x21),
+             std::vector<uint8_t>(19, 0x22),
+             std::vector<uint8_t>(19, 0x23)});
+
+        return card;
+    }
+};
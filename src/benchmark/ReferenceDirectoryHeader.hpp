@@ -0,0 +1,79 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/* Keypop Calypso Card */
+#include "keypop/calypso/card/card/DirectoryHeader.hpp"
+
+using keypop::calypso::card::WriteAccessLevel;
+using keypop::calypso::card::card::DirectoryHeader;
+
+/**
+ * In-memory reference implementation of DirectoryHeader.
+ */
+class ReferenceDirectoryHeader final : public DirectoryHeader {
+public:
+    ReferenceDirectoryHeader(
+        const uint16_t lid,
+        const uint8_t dfStatus,
+        const std::vector<uint8_t>& accessConditions,
+        const std::vector<uint8_t>& keyIndexes,
+        const std::array<uint8_t, 3>& kifs,
+        const std::array<uint8_t, 3>& kvcs)
+    : mLid(lid)
+    , mDfStatus(dfStatus)
+    , mAccessConditions(accessConditions)
+    , mKeyIndexes(keyIndexes)
+    , mKifs(kifs)
+    , mKvcs(kvcs) {
+    }
+
+    uint16_t
+    getLid() const override {
+        return mLid;
+    }
+
+    uint8_t
+    getDfStatus() const override {
+        return mDfStatus;
+    }
+
+    const std::vector<uint8_t>&
+    getAccessConditions() const override {
+        return mAccessConditions;
+    }
+
+    const std::vector<uint8_t>&
+    getKeyIndexes() const override {
+        return mKeyIndexes;
+    }
+
+    uint8_t
+    getKif(const WriteAccessLevel writeAccessLevel) const override {
+        return mKifs[static_cast<size_t>(writeAccessLevel)];
+    }
+
+    uint8_t
+    getKvc(const WriteAccessLevel writeAccessLevel) const override {
+        return mKvcs[static_cast<size_t>(writeAccessLevel)];
+    }
+
+private:
+    uint16_t mLid;
+    uint8_t mDfStatus;
+    std::vector<uint8_t> mAccessConditions;
+    std::vector<uint8_t> mKeyIndexes;
+    std::array<uint8_t, 3> mKifs;
+    std::array<uint8_t, 3> mKvcs;
+};
@@ -0,0 +1,84 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+/* Keypop Calypso Card */
+#include "keypop/calypso/card/card/ElementaryFile.hpp"
+
+/* Benchmark */
+#include "ReferenceFileData.hpp"
+#include "ReferenceFileHeader.hpp"
+
+using keypop::calypso::card::card::ElementaryFile;
+using keypop::calypso::card::card::FileData;
+using keypop::calypso::card::card::FileHeader;
+
+/**
+ * In-memory reference implementation of ElementaryFile.
+ */
+class ReferenceElementaryFile final : public ElementaryFile {
+public:
+    /**
+     * Creates a file whose data is written through to the provided card image under the provided
+     * key.
+     */
+    ReferenceElementaryFile(const uint8_t sfi, CardImage& cardImage, const FileKey file)
+    : mSfi(sfi), mData(std::make_shared<ReferenceFileData>(cardImage, file)) {
+    }
+
+    uint8_t
+    getSfi() const override {
+        return mSfi;
+    }
+
+    const std::shared_ptr<FileHeader>
+    getHeader() const override {
+        return mHeader;
+    }
+
+    const FileHeader*
+    getHeaderPtr() const override {
+        return mHeader.get();
+    }
+
+    const std::shared_ptr<FileData>
+    getData() const override {
+        return mData;
+    }
+
+    const FileData*
+    getDataPtr() const override {
+        return mData.get();
+    }
+
+    /**
+     * Sets the file header.
+     */
+    void
+    setHeader(const std::shared_ptr<ReferenceFileHeader> header) {
+        mHeader = header;
+    }
+
+    /**
+     * Gets the mutable file data.
+     */
+    ReferenceFileData&
+    getMutableData() {
+        return *mData;
+    }
+
+private:
+    uint8_t mSfi;
+    std::shared_ptr<ReferenceFileHeader> mHeader;
+    std::shared_ptr<ReferenceFileData> mData;
+};
@@ -0,0 +1,246 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+/* Keypop Calypso Card */
+#include "keypop/calypso/card/card/CardImage.hpp"
+#include "keypop/calypso/card/card/FileData.hpp"
+#include "keypop/calypso/card/card/FileKey.hpp"
+
+using keypop::calypso::card::ByteArrayView;
+using keypop::calypso::card::Optional;
+using keypop::calypso::card::card::CardImage;
+using keypop::calypso::card::card::CounterValues;
+using keypop::calypso::card::card::FileData;
+using keypop::calypso::card::card::FileKey;
+
+/**
+ * In-memory reference implementation of FileData, used to measure the cost of the interface
+ * contracts.
+ *
+ * <p>Each modification is also written to the card image of the owning card, so that the image is
+ * always up to date and never rebuilt.
+ */
+class ReferenceFileData final : public FileData {
+public:
+    /**
+     * Creates the data of a file, written through to the provided card image, which must outlive
+     * this object.
+     */
+    ReferenceFileData(CardImage& cardImage, const FileKey file)
+    : mCardImage(&cardImage), mFile(file) {}
+
+    const std::vector<uint8_t>
+    getContent() const override {
+        return getContent(1);
+    }
+
+    const std::vector<uint8_t>
+    getContent(const uint8_t numRecord) const override {
+        const auto it = mRecords.find(numRecord);
+        if (it == mRecords.end()) {
+            return std::vector<uint8_t>();
+        }
+
+        return it->second;
+    }
+
+    const std::vector<uint8_t>
+    getContent(const uint8_t numRecord, const uint8_t dataOffset, const uint8_t dataLength)
+        const override {
+        if (dataLength < 1) {
+            throw std::invalid_argument("dataLength");
+        }
+
+        const auto it = mRecords.find(numRecord);
+        if (it == mRecords.end()) {
+            return std::vector<uint8_t>();
+        }
+
+        if (static_cast<size_t>(dataOffset) + dataLength > it->second.size()) {
+            throw std::out_of_range("dataOffset + dataLength");
+        }
+
+        return std::vector<uint8_t>(
+            it->second.begin() + dataOffset, it->second.begin() + dataOffset + dataLength);
+    }
+
+    ByteArrayView
+    getContentView() const override {
+        return getContentView(1);
+    }
+
+    ByteArrayView
+    getContentView(const uint8_t numRecord) const override {
+        const auto it = mRecords.find(numRecord);
+        if (it == mRecords.end()) {
+            return ByteArrayView(nullptr, 0);
+        }
+
+        return it->second;
+    }
+
+    ByteArrayView
+    getContentView(const uint8_t numRecord, const uint8_t dataOffset, const uint8_t dataLength)
+        const override {
+        if (dataLength < 1) {
+            throw std::invalid_argument("dataLength");
+        }
+
+        const auto it = mRecords.find(numRecord);
+        if (it == mRecords.end()) {
+            return ByteArrayView(nullptr, 0);
+        }
+
+        if (static_cast<size_t>(dataOffset) + dataLength > it->second.size()) {
+            throw std::out_of_range("dataOffset + dataLength");
+        }
+
+        return ByteArrayView(it->second.data() + dataOffset, dataLength);
+    }
+
+    const std::map<const uint8_t, std::vector<uint8_t>>&
+    getAllRecordsContent() const override {
+        return mRecords;
+    }
+
+    const std::shared_ptr<int>
+    getContentAsCounterValue(const int numCounter) const override {
+        const Optional<int> value = getOptionalContentAsCounterValue(numCounter);
+        return value.isPresent() ? std::make_shared<int>(value.get()) : nullptr;
+    }
+
+    Optional<int>
+    getOptionalContentAsCounterValue(const int numCounter) const override {
+        if (numCounter < 1) {
+            throw std::invalid_argument("numCounter");
+        }
+
+        if (numCounter > CounterValues::MAX_COUNTERS) {
+            return Optional<int>();
+        }
+
+        return mCounters.getValue(numCounter);
+    }
+
+    const std::map<const int, const int>
+    getAllCountersValue() const override {
+        std::map<const int, const int> result;
+        for (int i = 1; i <= CounterValues::MAX_COUNTERS; i++) {
+            const Optional<int> value = mCounters.getValue(i);
+            if (value.isPresent()) {
+                result.insert({i, value.get()});
+            }
+        }
+
+        return result;
+    }
+
+    const CounterValues&
+    getCounterValues() const override {
+        return mCounters;
+    }
+
+    /**
+     * Replaces the content of a record.
+     */
+    void
+    setContent(const uint8_t numRecord, const std::vector<uint8_t>& content) {
+        mRecords[numRecord] = content;
+        mCardImage->setContent(mFile, numRecord, content);
+        if (numRecord == 1) {
+            mCounters.setFromRecord(content.data(), content.size());
+        }
+    }
+
+    /**
+     * Overwrites a part of a record, growing it if needed.
+     */
+    void
+    setContent(
+        const uint8_t numRecord, const uint8_t* content, const size_t length, const size_t offset) {
+        std::vector<uint8_t>& record = mRecords[numRecord];
+        if (record.size() < offset + length) {
+            record.resize(offset + length);
+        }
+
+        std::copy(content, content + length, record.begin() + offset);
+        mCardImage->setContent(mFile, numRecord, ByteArrayView(content, length), offset);
+        if (numRecord == 1) {
+            mCounters.setFromRecord(record.data(), record.size());
+        }
+    }
+
+    /**
+     * Performs a binary OR between a record and the provided data.
+     */
+    void
+    fillContent(
+        const uint8_t numRecord, const uint8_t* content, const size_t length, const size_t offset) {
+        std::vector<uint8_t>& record = mRecords[numRecord];
+        if (record.size() < offset + length) {
+            record.resize(offset + length);
+        }
+
+        for (size_t i = 0; i < length; i++) {
+            record[offset + i] |= content[i];
+        }
+        mCardImage->fillContent(mFile, numRecord, ByteArrayView(content, length), offset);
+
+        if (numRecord == 1) {
+            mCounters.setFromRecord(record.data(), record.size());
+        }
+    }
+
+    /**
+     * Shifts the records of a cyclic file (the oldest one is lost) and sets the new record #1.
+     */
+    void
+    addCyclicContent(const uint8_t* content, const size_t length) {
+        const uint8_t lastRecord = mRecords.empty() ? 0 : mRecords.rbegin()->first;
+        for (uint8_t record = lastRecord; record > 1; record--) {
+            const auto previous = mRecords.find(static_cast<uint8_t>(record - 1));
+            if (previous != mRecords.end()) {
+                mRecords[record] = previous->second;
+            } else {
+                mRecords.erase(record);
+            }
+        }
+
+        mRecords[1].assign(content, content + length);
+        mCardImage->addCyclicContent(mFile, ByteArrayView(content, length));
+        mCounters.setFromRecord(content, length);
+    }
+
+    /**
+     * Sets the value of a counter in record #1.
+     */
+    void
+    setCounter(const int numCounter, const int value) {
+        const uint8_t bytes[] = {
+            static_cast<uint8_t>(value >> 16),
+            static_cast<uint8_t>(value >> 8),
+            static_cast<uint8_t>(value)};
+        setContent(1, bytes, sizeof(bytes), static_cast<size_t>(numCounter - 1) * 3);
+    }
+
+private:
+    CardImage* mCardImage;
+    FileKey mFile;
+    std::map<const uint8_t, std::vector<uint8_t>> mRecords;
+    CounterValues mCounters;
+};
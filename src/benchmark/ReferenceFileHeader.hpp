@@ -0,0 +1,121 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/* Keypop Calypso Card */
+#include "keypop/calypso/card/card/FileHeader.hpp"
+
+using keypop::calypso::card::Optional;
+using keypop::calypso::card::card::ElementaryFile;
+using keypop::calypso::card::card::FileHeader;
+
+/**
+ * In-memory reference implementation of FileHeader.
+ */
+class ReferenceFileHeader final : public FileHeader {
+public:
+    ReferenceFileHeader(
+        const uint16_t lid,
+        const ElementaryFile::Type efType,
+        const int recordsNumber,
+        const int recordSize)
+    : mLid(lid)
+    , mEfType(efType)
+    , mRecordsNumber(recordsNumber)
+    , mRecordSize(recordSize)
+    , mAccessConditions(4, 0x00)
+    , mKeyIndexes(4, 0x00)
+    , mDfStatus(std::make_shared<uint8_t>(0x00))
+    , mSharedReference(std::make_shared<uint16_t>(0x0000)) {
+    }
+
+    ReferenceFileHeader(
+        const uint16_t lid,
+        const ElementaryFile::Type efType,
+        const int recordsNumber,
+        const int recordSize,
+        const std::vector<uint8_t>& accessConditions,
+        const std::vector<uint8_t>& keyIndexes,
+        const std::shared_ptr<uint8_t> dfStatus,
+        const std::shared_ptr<uint16_t> sharedReference)
+    : mLid(lid)
+    , mEfType(efType)
+    , mRecordsNumber(recordsNumber)
+    , mRecordSize(recordSize)
+    , mAccessConditions(accessConditions)
+    , mKeyIndexes(keyIndexes)
+    , mDfStatus(dfStatus)
+    , mSharedReference(sharedReference) {
+    }
+
+    uint16_t
+    getLid() const override {
+        return mLid;
+    }
+
+    const std::shared_ptr<uint8_t>
+    getDfStatus() const override {
+        return mDfStatus;
+    }
+
+    Optional<uint8_t>
+    getOptionalDfStatus() const override {
+        return mDfStatus ? Optional<uint8_t>(*mDfStatus) : Optional<uint8_t>();
+    }
+
+    ElementaryFile::Type
+    getEfType() const override {
+        return mEfType;
+    }
+
+    int
+    getRecordsNumber() const override {
+        return mRecordsNumber;
+    }
+
+    int
+    getRecordSize() const override {
+        return mRecordSize;
+    }
+
+    const std::vector<uint8_t>&
+    getAccessConditions() const override {
+        return mAccessConditions;
+    }
+
+    const std::vector<uint8_t>&
+    getKeyIndexes() const override {
+        return mKeyIndexes;
+    }
+
+    const std::shared_ptr<uint16_t>
+    getSharedReference() const override {
+        return mSharedReference;
+    }
+
+    Optional<uint16_t>
+    getOptionalSharedReference() const override {
+        return mSharedReference ? Optional<uint16_t>(*mSharedReference) : Optional<uint16_t>();
+    }
+
+private:
+    uint16_t mLid;
+    ElementaryFile::Type mEfType;
+    int mRecordsNumber;
+    int mRecordSize;
+    std::vector<uint8_t> mAccessConditions;
+    std::vector<uint8_t> mKeyIndexes;
+    std::shared_ptr<uint8_t> mDfStatus;
+    std::shared_ptr<uint16_t> mSharedReference;
+};
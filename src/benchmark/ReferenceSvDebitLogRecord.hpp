@@ -0,0 +1,76 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/* Keypop Calypso Card */
+#include "keypop/calypso/card/card/SvDebitLogRecord.hpp"
+
+using keypop::calypso::card::card::SvDebitLogRecord;
+
+/**
+ * In-memory reference implementation of SvDebitLogRecord, decoding the fields on each call from
+ * the raw log data.
+ */
+class ReferenceSvDebitLogRecord final : public SvDebitLogRecord {
+public:
+    explicit ReferenceSvDebitLogRecord(const std::vector<uint8_t>& rawData) : mRawData(rawData) {}
+
+    const std::vector<uint8_t>&
+    getRawData() const override {
+        return mRawData;
+    }
+
+    const std::vector<uint8_t>
+    getDebitDate() const override {
+        return std::vector<uint8_t>(mRawData.begin() + 2, mRawData.begin() + 4);
+    }
+
+    const std::vector<uint8_t>
+    getDebitTime() const override {
+        return std::vector<uint8_t>(mRawData.begin() + 4, mRawData.begin() + 6);
+    }
+
+    int
+    getAmount() const override {
+        return static_cast<int16_t>((mRawData[0] << 8) | mRawData[1]);
+    }
+
+    int
+    getBalance() const override {
+        const int value = (mRawData[14] << 16) | (mRawData[15] << 8) | mRawData[16];
+        return (value & 0x800000) ? value - 0x1000000 : value;
+    }
+
+    uint8_t
+    getKvc() const override {
+        return mRawData[6];
+    }
+
+    const std::vector<uint8_t>
+    getSamId() const override {
+        return std::vector<uint8_t>(mRawData.begin() + 7, mRawData.begin() + 11);
+    }
+
+    int
+    getSamTNum() const override {
+        return (mRawData[11] << 16) | (mRawData[12] << 8) | mRawData[13];
+    }
+
+    int
+    getSvTNum() const override {
+        return (mRawData[17] << 8) | mRawData[18];
+    }
+
+private:
+    std::vector<uint8_t> mRawData;
+};
@@ -0,0 +1,87 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/* Keypop Calypso Card */
+#include "keypop/calypso/card/card/SvLoadLogRecord.hpp"
+
+using keypop::calypso::card::card::SvLoadLogRecord;
+
+/**
+ * In-memory reference implementation of SvLoadLogRecord, decoding the fields on each call from
+ * the raw log data.
+ */
+class ReferenceSvLoadLogRecord final : public SvLoadLogRecord {
+public:
+    explicit ReferenceSvLoadLogRecord(const std::vector<uint8_t>& rawData) : mRawData(rawData) {}
+
+    const std::vector<uint8_t>&
+    getRawData() const override {
+        return mRawData;
+    }
+
+    const std::vector<uint8_t>
+    getLoadDate() const override {
+        return std::vector<uint8_t>(mRawData.begin(), mRawData.begin() + 2);
+    }
+
+    const std::vector<uint8_t>
+    getLoadTime() const override {
+        return std::vector<uint8_t>(mRawData.begin() + 11, mRawData.begin() + 13);
+    }
+
+    int
+    getAmount() const override {
+        return toSignedInt(8);
+    }
+
+    int
+    getBalance() const override {
+        return toSignedInt(5);
+    }
+
+    const std::vector<uint8_t>
+    getFreeData() const override {
+        return std::vector<uint8_t>{mRawData[2], mRawData[4]};
+    }
+
+    uint8_t
+    getKvc() const override {
+        return mRawData[3];
+    }
+
+    const std::vector<uint8_t>
+    getSamId() const override {
+        return std::vector<uint8_t>(mRawData.begin() + 13, mRawData.begin() + 17);
+    }
+
+    int
+    getSamTNum() const override {
+        return (mRawData[17] << 16) | (mRawData[18] << 8) | mRawData[19];
+    }
+
+    int
+    getSvTNum() const override {
+        return (mRawData[20] << 8) | mRawData[21];
+    }
+
+private:
+    int
+    toSignedInt(const size_t offset) const {
+        const int value
+            = (mRawData[offset] << 16) | (mRawData[offset + 1] << 8) | mRawData[offset + 2];
+        return (value & 0x800000) ? value - 0x1000000 : value;
+    }
+
+    std::vector<uint8_t> mRawData;
+};
@@ -0,0 +1,1643 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* Keypop Calypso Card */
+#include "keypop/calypso/card/transaction/TransactionManager.hpp"
+#include "keypop/calypso/card/transaction/UnexpectedCommandStatusException.hpp"
+
+/* Benchmark */
+#include "ReferenceCalypsoCard.hpp"
+#include "SimulatedCardReader.hpp"
+
+using keypop::calypso::card::ArrayView;
+using keypop::calypso::card::ByteArrayView;
+using keypop::calypso::card::GetDataTag;
+using keypop::calypso::card::SelectFileControl;
+using keypop::calypso::card::card::FileKey;
+using keypop::calypso::card::transaction::CardImageCache;
+using keypop::calypso::card::transaction::CardTransactionExecutor;
+using keypop::calypso::card::transaction::CardTransactionObserver;
+using keypop::calypso::card::transaction::ChannelControl;
+using keypop::calypso::card::transaction::SearchCommandData;
+using keypop::calypso::card::transaction::TransactionAuditSink;
+using keypop::calypso::card::transaction::TransactionManager;
+using keypop::calypso::card::transaction::UnexpectedCommandStatusException;
+using keypop::reader::CardReader;
+
+/**
+ * In-memory reference implementation of TransactionManager.
+ *
+ * <p>The "prepare" methods validate their arguments and build the corresponding APDUs as a real
+ * implementation would. The processing applies the modifications directly to the associated
+ * {@link ReferenceCalypsoCard} and records the APDUs in the audit data.
+ *
+ * <p>When the card reader is a {@link SimulatedCardReader}, the APDUs are transmitted to the
+ * simulated card, the actual responses are recorded in the audit data, the read data is stored in
+ * the card image and any status word other than 9000h raises an
+ * UnexpectedCommandStatusException. Otherwise no I/O is done and a 9000h response is assumed.
+ * This is the only class allowed to transmit through a SimulatedCardReader (see its
+ * documentation).
+ */
+class ReferenceTransactionManager final : public TransactionManager<ReferenceTransactionManager> {
+public:
+    ReferenceTransactionManager(
+        const std::shared_ptr<CardReader> cardReader,
+        const std::shared_ptr<ReferenceCalypsoCard> card)
+    : mCardReader(cardReader)
+    , mSimulatedCardReader(std::dynamic_pointer_cast<SimulatedCardReader>(cardReader))
+    , mCard(card)
+    , mCurrentSfi(0)
+    , mAuditDataHead(0)
+    , mAuditDataSize(0)
+    , mAuditDataMaxSize(std::numeric_limits<size_t>::max())
+    , mCachedReadsSkipping(false)
+    , mSessionCounterReported(false)
+    , mCardImageCacheUsable(false)
+    , mCardImageStale(false)
+    , mSessionOpen(false)
+    , mSessionOpenAfterPreparedCommands(false)
+    , mAsyncProcessing(false) {
+    }
+
+    ReferenceTransactionManager&
+    prepareSelectFile(const uint16_t lid) override {
+        /* The selected EF becomes the current EF, known by its SFI if its header has been read */
+        const ElementaryFile* ef = mCard->getFileByLidPtr(lid);
+        mCurrentSfi = ef != nullptr ? ef->getSfi() : 0;
+        return addCommand(
+            CommandType::OTHER,
+            0,
+            0,
+            0,
+            {0x00,
+             0xA4,
+             0x09,
+             0x00,
+             0x02,
+             static_cast<uint8_t>(lid >> 8),
+             static_cast<uint8_t>(lid),
+             0x00});
+    }
+
+    ReferenceTransactionManager&
+    prepareSelectFile(const SelectFileControl selectFileControl) override {
+        mCurrentSfi = 0;
+        return addCommand(
+            CommandType::OTHER,
+            0,
+            0,
+            0,
+            {0x00, 0xA4, 0x02, static_cast<uint8_t>(selectFileControl), 0x02, 0x00, 0x00, 0x00});
+    }
+
+    ReferenceTransactionManager&
+    prepareGetData(const GetDataTag tag) override {
+        return addCommand(
+            CommandType::OTHER, 0, 0, 0, {0x00, 0xCA, 0x00, static_cast<uint8_t>(tag), 0x00});
+    }
+
+    ReferenceTransactionManager&
+    prepareReadRecord(const uint8_t sfi, const int recordNumber) override {
+        checkSfi(sfi);
+        checkRange(recordNumber, 1, 250, "recordNumber");
+        const uint8_t targetSfi = resolveSfi(sfi);
+        if (isCached(CommandType::READ_RECORD, targetSfi, recordNumber, recordNumber, 0, 0)) {
+            return *this;
+        }
+
+        return addRead(
+            {CommandType::READ_RECORD, targetSfi, recordNumber, recordNumber, 0, 0, 0, 0, {}});
+    }
+
+    ReferenceTransactionManager&
+    prepareReadRecords(
+        const uint8_t sfi,
+        const int fromRecordNumber,
+        const int toRecordNumber,
+        const int recordSize) override {
+        checkSfi(sfi);
+        checkRange(fromRecordNumber, 1, 250, "fromRecordNumber");
+        checkRange(toRecordNumber, fromRecordNumber, 250, "toRecordNumber");
+        checkRange(recordSize, 1, 250, "recordSize");
+        const uint8_t targetSfi = resolveSfi(sfi);
+        if (isCached(
+                CommandType::READ_RECORDS, targetSfi, fromRecordNumber, toRecordNumber, 0, 0)) {
+            return *this;
+        }
+
+        /* Splits according to the payload capacity */
+        const int nbRecordsPerApdu = std::max(1, PAYLOAD_CAPACITY / (recordSize + 2));
+        for (int from = fromRecordNumber; from <= toRecordNumber; from += nbRecordsPerApdu) {
+            const int to = std::min(toRecordNumber, from + nbRecordsPerApdu - 1);
+            addRead({CommandType::READ_RECORDS, targetSfi, from, to, recordSize, 0, 0, 0, {}});
+        }
+
+        return *this;
+    }
+
+    ReferenceTransactionManager&
+    prepareReadRecordsPartially(
+        const uint8_t sfi,
+        const int fromRecordNumber,
+        const int toRecordNumber,
+        const int offset,
+        const int nbBytesToRead) override {
+        checkSfi(sfi);
+        checkRange(fromRecordNumber, 1, 250, "fromRecordNumber");
+        checkRange(toRecordNumber, fromRecordNumber, 250, "toRecordNumber");
+        checkRange(offset, 0, 249, "offset");
+        checkRange(nbBytesToRead, 1, 250 - offset, "nbBytesToRead");
+        const uint8_t targetSfi = resolveSfi(sfi);
+        if (isCached(
+                CommandType::READ_PARTIALLY,
+                targetSfi,
+                fromRecordNumber,
+                toRecordNumber,
+                offset,
+                nbBytesToRead)) {
+            return *this;
+        }
+
+        /* Splits according to the payload capacity */
+        const int nbRecordsPerApdu = PAYLOAD_CAPACITY / nbBytesToRead;
+        for (int from = fromRecordNumber; from <= toRecordNumber; from += nbRecordsPerApdu) {
+            const int to = std::min(toRecordNumber, from + nbRecordsPerApdu - 1);
+            addRead(
+                {CommandType::READ_PARTIALLY,
+                 targetSfi,
+                 from,
+                 to,
+                 0,
+                 offset,
+                 nbBytesToRead,
+                 0,
+                 {}});
+        }
+
+        return *this;
+    }
+
+    ReferenceTransactionManager&
+    prepareReadBinary(const uint8_t sfi, const int offset, const int nbBytesToRead) override {
+        checkSfi(sfi);
+        checkRange(offset, 0, 32767, "offset");
+        checkRange(nbBytesToRead, 1, 32767, "nbBytesToRead");
+        const uint8_t targetSfi = resolveSfi(sfi);
+        if (isCached(CommandType::READ_BINARY, targetSfi, 1, 1, offset, nbBytesToRead)) {
+            return *this;
+        }
+
+        /* Splits according to the payload capacity */
+        const int end = offset + nbBytesToRead;
+        for (int begin = offset; begin < end; begin += PAYLOAD_CAPACITY) {
+            const int length = std::min(end - begin, static_cast<int>(PAYLOAD_CAPACITY));
+            addRead({CommandType::READ_BINARY, targetSfi, 1, 1, 0, begin, length, 0, {}});
+        }
+
+        return *this;
+    }
+
+    ReferenceTransactionManager&
+    prepareReadCounter(const uint8_t sfi, const int nbCountersToRead) override {
+        checkSfi(sfi);
+        checkRange(nbCountersToRead, 1, 83, "nbCountersToRead");
+        const uint8_t targetSfi = resolveSfi(sfi);
+        if (isCached(CommandType::READ_RECORD, targetSfi, 1, 1, 0, nbCountersToRead * 3)) {
+            return *this;
+        }
+
+        return addRead(
+            {CommandType::READ_RECORD, targetSfi, 1, 1, 0, 0, nbCountersToRead * 3, 0, {}});
+    }
+
+    ReferenceTransactionManager&
+    prepareSearchRecords(const std::shared_ptr<SearchCommandData> data) override {
+        if (!data) {
+            throw std::invalid_argument("data");
+        }
+
+        return addCommand(CommandType::OTHER, 0, 0, 0, {0x00, 0xA2, 0x01, 0x07, 0x00});
+    }
+
+    ReferenceTransactionManager&
+    prepareCheckPinStatus() override {
+        return addCommand(CommandType::OTHER, 0, 0, 0, {0x00, 0x20, 0x00, 0x00, 0x00});
+    }
+
+    ReferenceTransactionManager&
+    prepareAppendRecord(const uint8_t sfi, const std::vector<uint8_t>& recordData) override {
+        return prepareAppendRecord(sfi, ByteArrayView(recordData));
+    }
+
+    ReferenceTransactionManager&
+    prepareAppendRecord(const uint8_t sfi, const ByteArrayView recordData) override {
+        checkSfi(sfi);
+        checkRange(static_cast<int>(recordData.size()), 1, 250, "recordData");
+        const uint8_t targetSfi = resolveSfi(sfi);
+        return addWriteCommand(
+            CommandType::APPEND_RECORD,
+            targetSfi,
+            1,
+            0,
+            {0x00, 0xE2, 0x00, sfiToP2(targetSfi)},
+            recordData);
+    }
+
+    ReferenceTransactionManager&
+    prepareUpdateRecord(
+        const uint8_t sfi,
+        const int recordNumber,
+        const std::vector<uint8_t>& recordData) override {
+        return prepareUpdateRecord(sfi, recordNumber, ByteArrayView(recordData));
+    }
+
+    ReferenceTransactionManager&
+    prepareUpdateRecord(
+        const uint8_t sfi, const int recordNumber, const ByteArrayView recordData) override {
+        checkSfi(sfi);
+        checkRange(recordNumber, 1, 250, "recordNumber");
+        checkRange(static_cast<int>(recordData.size()), 1, 250, "recordData");
+        const uint8_t targetSfi = resolveSfi(sfi);
+        return addWriteCommand(
+            CommandType::UPDATE_RECORD,
+            targetSfi,
+            recordNumber,
+            0,
+            {0x00,
+             0xDC,
+             static_cast<uint8_t>(recordNumber),
+             static_cast<uint8_t>(targetSfi * 8 + 4)},
+            recordData);
+    }
+
+    ReferenceTransactionManager&
+    prepareWriteRecord(
+        const uint8_t sfi,
+        const int recordNumber,
+        const std::vector<uint8_t>& recordData) override {
+        return prepareWriteRecord(sfi, recordNumber, ByteArrayView(recordData));
+    }
+
+    ReferenceTransactionManager&
+    prepareWriteRecord(
+        const uint8_t sfi, const int recordNumber, const ByteArrayView recordData) override {
+        checkSfi(sfi);
+        checkRange(recordNumber, 1, 250, "recordNumber");
+        checkRange(static_cast<int>(recordData.size()), 1, 250, "recordData");
+        const uint8_t targetSfi = resolveSfi(sfi);
+        return addWriteCommand(
+            CommandType::WRITE_RECORD,
+            targetSfi,
+            recordNumber,
+            0,
+            {0x00,
+             0xD2,
+             static_cast<uint8_t>(recordNumber),
+             static_cast<uint8_t>(targetSfi * 8 + 4)},
+            recordData);
+    }
+
+    ReferenceTransactionManager&
+    prepareUpdateBinary(
+        const uint8_t sfi, const int offset, const std::vector<uint8_t>& data) override {
+        return prepareUpdateBinary(sfi, offset, ByteArrayView(data));
+    }
+
+    ReferenceTransactionManager&
+    prepareUpdateBinary(const uint8_t sfi, const int offset, const ByteArrayView data) override {
+        checkSfi(sfi);
+        checkRange(offset, 0, 32767, "offset");
+        checkRange(static_cast<int>(data.size()), 1, 32767, "data");
+        const uint8_t targetSfi = resolveSfi(sfi);
+        return addBinaryWriteCommand(CommandType::UPDATE_BINARY, 0xD6, targetSfi, offset, data);
+    }
+
+    ReferenceTransactionManager&
+    prepareWriteBinary(
+        const uint8_t sfi, const int offset, const std::vector<uint8_t>& data) override {
+        return prepareWriteBinary(sfi, offset, ByteArrayView(data));
+    }
+
+    ReferenceTransactionManager&
+    prepareWriteBinary(const uint8_t sfi, const int offset, const ByteArrayView data) override {
+        checkSfi(sfi);
+        checkRange(offset, 0, 32767, "offset");
+        checkRange(static_cast<int>(data.size()), 1, 32767, "data");
+        const uint8_t targetSfi = resolveSfi(sfi);
+        return addBinaryWriteCommand(CommandType::WRITE_BINARY, 0xD0, targetSfi, offset, data);
+    }
+
+    ReferenceTransactionManager&
+    prepareIncreaseCounter(
+        const uint8_t sfi, const int counterNumber, const int incValue) override {
+        return addCounterCommand(CommandType::INCREASE, 0x32, sfi, counterNumber, incValue);
+    }
+
+    ReferenceTransactionManager&
+    prepareIncreaseCounters(
+        const uint8_t sfi,
+        const std::map<const int, const int>& counterNumberToIncValueMap) override {
+        if (counterNumberToIncValueMap.empty()) {
+            throw std::invalid_argument("counterNumberToIncValueMap");
+        }
+
+        for (const auto& entry : counterNumberToIncValueMap) {
+            prepareIncreaseCounter(sfi, entry.first, entry.second);
+        }
+
+        return *this;
+    }
+
+    ReferenceTransactionManager&
+    prepareIncreaseCounters(
+        const uint8_t sfi,
+        const ArrayView<std::pair<int, int>> counterNumberToIncValues) override {
+        return addCounterCommands(CommandType::INCREASE, 0x32, sfi, counterNumberToIncValues);
+    }
+
+    ReferenceTransactionManager&
+    prepareDecreaseCounter(
+        const uint8_t sfi, const int counterNumber, const int decValue) override {
+        return addCounterCommand(CommandType::DECREASE, 0x30, sfi, counterNumber, decValue);
+    }
+
+    ReferenceTransactionManager&
+    prepareDecreaseCounters(
+        const uint8_t sfi,
+        const std::map<const int, const int>& counterNumberToDecValueMap) override {
+        if (counterNumberToDecValueMap.empty()) {
+            throw std::invalid_argument("counterNumberToDecValueMap");
+        }
+
+        for (const auto& entry : counterNumberToDecValueMap) {
+            prepareDecreaseCounter(sfi, entry.first, entry.second);
+        }
+
+        return *this;
+    }
+
+    ReferenceTransactionManager&
+    prepareDecreaseCounters(
+        const uint8_t sfi,
+        const ArrayView<std::pair<int, int>> counterNumberToDecValues) override {
+        return addCounterCommands(CommandType::DECREASE, 0x30, sfi, counterNumberToDecValues);
+    }
+
+    ReferenceTransactionManager&
+    prepareSetCounter(const uint8_t sfi, const int counterNumber, const int newValue) override {
+        checkSfi(sfi);
+        const ElementaryFile* ef = mCard->getFileBySfiPtr(sfi != 0 ? sfi : mCurrentSfi);
+        if (ef == nullptr) {
+            throw std::logic_error("Unknown counter value");
+        }
+
+        const int oldValue = ef->getDataPtr()->getCounterValues().getValue(counterNumber).get();
+        return newValue >= oldValue
+                   ? prepareIncreaseCounter(sfi, counterNumber, newValue - oldValue)
+                   : prepareDecreaseCounter(sfi, counterNumber, oldValue - newValue);
+    }
+
+    ReferenceTransactionManager&
+    prepareSvReadAllLogs() override {
+        prepareReadRecord(0x14, 1);
+        return prepareReadRecords(0x15, 1, 3, 29);
+    }
+
+    ReferenceTransactionManager&
+    prepareVerifyPin(const std::vector<uint8_t>& pin) override {
+        checkRange(static_cast<int>(pin.size()), 4, 4, "pin");
+        return addWriteCommand(
+            CommandType::OTHER, 0, 0, 0, {0x00, 0x20, 0x00, 0x00}, ByteArrayView(pin));
+    }
+
+    ReferenceTransactionManager&
+    prepareChangePin(const std::vector<uint8_t>& newPin) override {
+        checkRange(static_cast<int>(newPin.size()), 4, 4, "newPin");
+        return addWriteCommand(
+            CommandType::OTHER, 0, 0, 0, {0x00, 0xD8, 0x00, 0xFF}, ByteArrayView(newPin));
+    }
+
+    ReferenceTransactionManager&
+    enableCachedReadsSkipping() override {
+        mCachedReadsSkipping = true;
+        return *this;
+    }
+
+    ReferenceTransactionManager&
+    setCardImageCache(const std::shared_ptr<CardImageCache> cache) override {
+        checkNoAsyncProcessing();
+        mCardImageCache = cache;
+        return *this;
+    }
+
+    int
+    getPreparedApduCount() const override {
+        return static_cast<int>(
+            std::count_if(mCommands.begin(), mCommands.end(), [](const Command& command) {
+                return !isCachedRead(command.type);
+            }));
+    }
+
+    ReferenceTransactionManager&
+    processCommands(const ChannelControl channelControl) override {
+        (void)channelControl;
+        checkNoAsyncProcessing();
+
+        startProcessing();
+        try {
+            for (const Command& command : mCommands) {
+                processCommand(command);
+            }
+        } catch (...) {
+            /* The commands not sent leave the current EF unknown */
+            mCurrentSfi = 0;
+            endProcessing();
+            throw;
+        }
+
+        endProcessing();
+
+        return *this;
+    }
+
+    void
+    processCommandsAsync(
+        const ChannelControl channelControl,
+        const std::shared_ptr<CardTransactionExecutor> executor,
+        const std::function<void(const std::exception_ptr)>& completionCallback) override {
+        (void)channelControl;
+        if (!executor || !completionCallback) {
+            throw std::invalid_argument("executor/completionCallback");
+        }
+
+        if (mAsyncProcessing.exchange(true)) {
+            throw std::logic_error("Asynchronous processing already in progress");
+        }
+
+        startProcessing();
+        submitStep(0, executor, completionCallback);
+    }
+
+    ReferenceTransactionManager&
+    reset(
+        const std::shared_ptr<CardReader> cardReader,
+        const std::shared_ptr<CalypsoCard> card) override {
+        checkNoAsyncProcessing();
+        if (mSessionOpen) {
+            throw std::logic_error("Secure session open");
+        }
+
+        const std::shared_ptr<ReferenceCalypsoCard> referenceCard
+            = std::dynamic_pointer_cast<ReferenceCalypsoCard>(card);
+        if (!referenceCard) {
+            throw std::invalid_argument("card");
+        }
+
+        if (referenceCard != mCard) {
+            mCardImageStale = false;
+        }
+
+        mCardReader = cardReader;
+        mSimulatedCardReader = std::dynamic_pointer_cast<SimulatedCardReader>(cardReader);
+        mCard = referenceCard;
+        mCommands.clear();
+        mCurrentSfi = 0;
+        mCachedReads.clear();
+        mAuditData.clear();
+        mAuditDataHead = 0;
+        mAuditDataSize = 0;
+        mSessionCounterReported = false;
+        mCardImageCacheUsable = false;
+        mSessionOpen = false;
+        mSessionOpenAfterPreparedCommands = false;
+
+        return *this;
+    }
+
+    ReferenceTransactionManager&
+    setTransactionObserver(const std::shared_ptr<CardTransactionObserver> observer) override {
+        checkNoAsyncProcessing();
+        mObserver = observer;
+        return *this;
+    }
+
+    ReferenceTransactionManager&
+    setTransactionAuditSink(const std::shared_ptr<TransactionAuditSink> sink) override {
+        checkNoAsyncProcessing();
+        mAuditSink = sink;
+        return *this;
+    }
+
+    ReferenceTransactionManager&
+    setTransactionAuditDataMaxSize(const size_t maxSize) override {
+        checkNoAsyncProcessing();
+        mAuditDataMaxSize = maxSize;
+        discardOldestAuditData();
+
+        return *this;
+    }
+
+    const std::vector<std::vector<uint8_t>>&
+    getTransactionAuditData() const override {
+        compactAuditData();
+        return mAuditData;
+    }
+
+    /*
+     * The following methods are not part of the TransactionManager interface: they let the
+     * benchmarks run complete secure sessions against a SimulatedCalypsoCard.
+     */
+
+    /**
+     * Schedules the opening of a secure session reading the provided record.
+     */
+    ReferenceTransactionManager&
+    prepareOpenSecureSession(const uint8_t sfi, const int recordNumber) {
+        checkSfi(sfi);
+        checkRange(recordNumber, 0, 31, "recordNumber");
+        /* The record read makes its EF the current EF */
+        const uint8_t targetSfi = recordNumber != 0 ? resolveSfi(sfi) : sfi;
+        mSessionOpenAfterPreparedCommands = true;
+        return addCommand(
+            CommandType::OPEN_SESSION,
+            targetSfi,
+            recordNumber,
+            0,
+            {0x00,
+             0x8A,
+             static_cast<uint8_t>(recordNumber * 8 + 3),
+             static_cast<uint8_t>(targetSfi * 8 + 1),
+             0x04,
+             0xC1,
+             0xC2,
+             0xC3,
+             0xC4,
+             0x00});
+    }
+
+    /**
+     * Schedules the closing (or the cancellation) of the secure session.
+     */
+    ReferenceTransactionManager&
+    prepareCloseSecureSession(const bool abort) {
+        mSessionOpenAfterPreparedCommands = false;
+        if (abort) {
+            return addCommand(CommandType::CLOSE_SESSION, 0, 0, 0, {0x00, 0x8E, 0x00, 0x00, 0x00});
+        }
+
+        return addCommand(
+            CommandType::CLOSE_SESSION,
+            0,
+            0,
+            0,
+            {0x00, 0x8E, 0x80, 0x00, 0x04, 0x5C, 0x5C, 0x5C, 0x5C, 0x00});
+    }
+
+    /**
+     * Schedules an SV GET command.
+     */
+    ReferenceTransactionManager&
+    prepareSvGet() {
+        return addCommand(CommandType::SV_GET, 0, 0, 0, {0x00, 0x7C, 0x00, 0x07, 0x00});
+    }
+
+    /**
+     * Schedules an SV RELOAD (positive amount) or an SV DEBIT (negative amount) command.
+     */
+    ReferenceTransactionManager&
+    prepareSvOperation(const int amount) {
+        if (amount >= 0) {
+            checkRange(amount, 0, 0x7FFFFF, "amount");
+            return addCommand(
+                CommandType::OTHER,
+                0,
+                0,
+                0,
+                {0x00,
+                 0xB8,
+                 0x55,
+                 0x00,
+                 0x07,
+                 static_cast<uint8_t>(amount >> 16),
+                 static_cast<uint8_t>(amount >> 8),
+                 static_cast<uint8_t>(amount),
+                 0x12,
+                 0x34,
+                 0x05,
+                 0x67});
+        }
+
+        checkRange(-amount, 1, 0x7FFF, "amount");
+        return addCommand(
+            CommandType::OTHER,
+            0,
+            0,
+            0,
+            {0x00,
+             0xBA,
+             0x55,
+             0x00,
+             0x06,
+             static_cast<uint8_t>(-amount >> 8),
+             static_cast<uint8_t>(-amount),
+             0x12,
+             0x34,
+             0x05,
+             0x67});
+    }
+
+private:
+    enum class CommandType {
+        OTHER,
+        READ_RECORD,
+        READ_RECORDS,
+        READ_PARTIALLY,
+        READ_BINARY,
+        CACHED_RECORDS,
+        CACHED_BINARY,
+        OPEN_SESSION,
+        CLOSE_SESSION,
+        SV_GET,
+        APPEND_RECORD,
+        UPDATE_RECORD,
+        WRITE_RECORD,
+        UPDATE_BINARY,
+        WRITE_BINARY,
+        INCREASE,
+        DECREASE
+    };
+
+    /**
+     * Maximum length of the card responses.
+     */
+    static const int PAYLOAD_CAPACITY = 250;
+
+    /**
+     * Highest counter number of a counters EF.
+     */
+    static const int MAX_COUNTER_NUMBER = 83;
+
+    struct Command {
+        CommandType type;
+        uint8_t sfi;
+        int recordNumber;
+        int toRecordNumber;
+        int recordSize;
+        int offset;
+        int value;
+        size_t dataOffset;
+        std::vector<uint8_t> apdu;
+    };
+
+    static void
+    checkSfi(const uint8_t sfi) {
+        checkRange(sfi, 0, 30, "sfi");
+    }
+
+    /**
+     * Returns the SFI of the EF addressed by a command prepared with the provided SFI, which then
+     * becomes the current EF. SFI 0 designates the current EF: it is resolved to the SFI of the EF
+     * addressed by the previous commands, so that the command is sent with this SFI and its data
+     * is keyed in the card image. It stays 0 if this EF is unknown, in which case the command is
+     * sent as is and its data is kept out of the card image, its journal and the cache.
+     */
+    uint8_t
+    resolveSfi(const uint8_t sfi) {
+        if (sfi != 0) {
+            mCurrentSfi = sfi;
+        }
+
+        return mCurrentSfi;
+    }
+
+    static void
+    checkRange(const int value, const int min, const int max, const char* name) {
+        if (value < min || value > max) {
+            throw std::invalid_argument(name);
+        }
+    }
+
+    static uint8_t
+    sfiToP2(const uint8_t sfi) {
+        return static_cast<uint8_t>(sfi * 8);
+    }
+
+    ReferenceTransactionManager&
+    addCommand(
+        const CommandType type,
+        const uint8_t sfi,
+        const int recordNumber,
+        const int offset,
+        std::vector<uint8_t>&& apdu) {
+        mCommands.push_back({type, sfi, recordNumber, 0, 0, offset, 0, 0, std::move(apdu)});
+        notifyCommandPrepared();
+        return *this;
+    }
+
+    ReferenceTransactionManager&
+    addWriteCommand(
+        const CommandType type,
+        const uint8_t sfi,
+        const int recordNumber,
+        const int offset,
+        std::vector<uint8_t>&& header,
+        const ByteArrayView data) {
+        header.reserve(header.size() + 1 + data.size());
+        header.push_back(static_cast<uint8_t>(data.size()));
+        const size_t dataOffset = header.size();
+        header.insert(header.end(), data.begin(), data.end());
+        mCommands.push_back(
+            {type, sfi, recordNumber, 0, 0, offset, 0, dataOffset, std::move(header)});
+        notifyCommandPrepared();
+        return *this;
+    }
+
+    ReferenceTransactionManager&
+    addBinaryWriteCommand(
+        const CommandType type,
+        const uint8_t ins,
+        const uint8_t sfi,
+        const int offset,
+        const ByteArrayView data) {
+        if (offset > 255) {
+            addBinaryFileSelection(sfi);
+        }
+
+        std::vector<uint8_t> header = {0x00, ins, 0x00, 0x00};
+        encodeBinaryOffset(sfi, offset, header);
+        return addWriteCommand(type, sfi, 1, offset, std::move(header), data);
+    }
+
+    /**
+     * Validates the whole array before preparing anything, then prepares the commands in ascending
+     * order of counter number, as the map overloads do.
+     */
+    ReferenceTransactionManager&
+    addCounterCommands(
+        const CommandType type,
+        const uint8_t ins,
+        const uint8_t sfi,
+        const ArrayView<std::pair<int, int>> counterNumberToValues) {
+        if (counterNumberToValues.empty()) {
+            throw std::invalid_argument("counterNumberToValues");
+        }
+
+        checkSfi(sfi);
+        std::bitset<MAX_COUNTER_NUMBER + 1> counters;
+        std::array<int, MAX_COUNTER_NUMBER + 1> values;
+        for (const auto& entry : counterNumberToValues) {
+            checkRange(entry.first, 0, MAX_COUNTER_NUMBER, "counterNumber");
+            checkRange(entry.second, 0, 16777215, "value");
+            if (counters.test(entry.first)) {
+                throw std::invalid_argument("counterNumber");
+            }
+
+            counters.set(entry.first);
+            values[entry.first] = entry.second;
+        }
+
+        for (int counterNumber = 0; counterNumber <= MAX_COUNTER_NUMBER; counterNumber++) {
+            if (counters.test(counterNumber)) {
+                addCounterCommand(type, ins, sfi, counterNumber, values[counterNumber]);
+            }
+        }
+
+        return *this;
+    }
+
+    ReferenceTransactionManager&
+    addCounterCommand(
+        const CommandType type,
+        const uint8_t ins,
+        const uint8_t sfi,
+        const int counterNumber,
+        const int value) {
+        checkSfi(sfi);
+        checkRange(counterNumber, 0, MAX_COUNTER_NUMBER, "counterNumber");
+        checkRange(value, 0, 16777215, "value");
+        const uint8_t targetSfi = resolveSfi(sfi);
+        mCommands.push_back(
+            {type,
+             targetSfi,
+             counterNumber,
+             0,
+             0,
+             0,
+             value,
+             0,
+             {0x00,
+              ins,
+              static_cast<uint8_t>(counterNumber),
+              sfiToP2(targetSfi),
+              0x03,
+              static_cast<uint8_t>(value >> 16),
+              static_cast<uint8_t>(value >> 8),
+              static_cast<uint8_t>(value),
+              0x00}});
+        notifyCommandPrepared();
+        return *this;
+    }
+
+    static bool
+    isModification(const CommandType type) {
+        return type != CommandType::OTHER && type != CommandType::READ_RECORD
+               && type != CommandType::READ_RECORDS && type != CommandType::READ_PARTIALLY
+               && type != CommandType::READ_BINARY && type != CommandType::SV_GET
+               && !isCachedRead(type);
+    }
+
+    static bool
+    isRead(const CommandType type) {
+        return type == CommandType::READ_RECORD || type == CommandType::READ_RECORDS
+               || type == CommandType::READ_PARTIALLY || type == CommandType::READ_BINARY;
+    }
+
+    /**
+     * Indicates whether the command modifies the EF having the provided SFI, or may modify it
+     * because it addresses an unknown current EF (see resolveSfi()).
+     */
+    static bool
+    mayModify(const Command& command, const uint8_t sfi) {
+        return (command.sfi == sfi || command.sfi == 0) && isModification(command.type)
+               && command.type != CommandType::OPEN_SESSION
+               && command.type != CommandType::CLOSE_SESSION;
+    }
+
+    /**
+     * Indicates whether the command is a read served from the card image cache, which sends no
+     * APDU.
+     */
+    static bool
+    isCachedRead(const CommandType type) {
+        return type == CommandType::CACHED_RECORDS || type == CommandType::CACHED_BINARY;
+    }
+
+    /**
+     * Indicates whether the read can be dropped because the bytes it would return are known in the
+     * card image, or has been replaced by a read served from the card image cache. The read covers
+     * nbBytes bytes from the offset in each of the records, or the whole records if nbBytes is 0.
+     */
+    bool
+    isCached(
+        const CommandType type,
+        const uint8_t sfi,
+        const int from,
+        const int to,
+        const int offset,
+        const int nbBytes) {
+        /* The data of an unknown current EF cannot be looked up */
+        if (sfi == 0) {
+            return false;
+        }
+
+        /* Prepared modifications of the EF make the images outdated */
+        for (const Command& command : mCommands) {
+            if (mayModify(command, sfi)) {
+                return false;
+            }
+        }
+
+        const FileKey file = FileKey::ofSfi(sfi);
+        if (mCachedReadsSkipping && !mCardImageStale && !mSessionOpenAfterPreparedCommands
+            && covers(mCard->getCardImage(), file, from, to, offset, nbBytes)) {
+            return true;
+        }
+
+        return addCachedRead(type, file, from, to, offset, nbBytes);
+    }
+
+    /**
+     * Indicates whether the image knows the bytes returned by a read (see isCached()).
+     */
+    static bool
+    covers(
+        const CardImage& image,
+        const FileKey file,
+        const int from,
+        const int to,
+        const int offset,
+        const int nbBytes) {
+        for (int i = from; i <= to; i++) {
+            const uint8_t numRecord = static_cast<uint8_t>(i);
+            if (nbBytes == 0 ? !image.isComplete(file, numRecord)
+                             : !image.isKnown(
+                                 file,
+                                 numRecord,
+                                 static_cast<size_t>(offset),
+                                 static_cast<size_t>(nbBytes))) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * Prepares a read served from the card image cache if the cached image of the card knows the
+     * bytes it would return (see setCardImageCache()). These bytes are copied into mCachedReads,
+     * then into the card image by the processing.
+     */
+    bool
+    addCachedRead(
+        const CommandType type,
+        const FileKey file,
+        const int from,
+        const int to,
+        const int offset,
+        const int nbBytes) {
+        if (!mCardImageCacheUsable || !mCardImageCache || !mCardImageCache->isCacheable(file)) {
+            return false;
+        }
+
+        const CardImage* image = mCardImageCache->find(
+            mCard->getApplicationSerialNumber(), mCard->getTransactionCounter());
+        if (image == nullptr || !covers(*image, file, from, to, offset, nbBytes)) {
+            return false;
+        }
+
+        for (int i = from; i <= to; i++) {
+            const uint8_t numRecord = static_cast<uint8_t>(i);
+            const ByteArrayView content = image->getContent(file, numRecord);
+            if (nbBytes == 0) {
+                mCachedReads.setContent(file, numRecord, content);
+            } else {
+                mCachedReads.setContent(
+                    file,
+                    numRecord,
+                    ByteArrayView(content.data() + offset, static_cast<size_t>(nbBytes)),
+                    static_cast<size_t>(offset));
+            }
+        }
+
+        mCommands.push_back(
+            {type == CommandType::READ_BINARY ? CommandType::CACHED_BINARY
+                                              : CommandType::CACHED_RECORDS,
+             static_cast<uint8_t>(file.getId()),
+             from,
+             to,
+             0,
+             offset,
+             nbBytes,
+             0,
+             {}});
+
+        return true;
+    }
+
+    /**
+     * Copies the bytes of a read served from the card image cache into the card image.
+     */
+    void
+    applyCachedRead(const Command& command) {
+        const FileKey file = FileKey::ofSfi(command.sfi);
+        ReferenceFileData& data = mCard->getOrCreateFile(command.sfi).getMutableData();
+        const size_t offset = static_cast<size_t>(command.offset);
+        for (int i = command.recordNumber; i <= command.toRecordNumber; i++) {
+            const uint8_t numRecord = static_cast<uint8_t>(i);
+            const ByteArrayView content = mCachedReads.getContent(file, numRecord);
+            if (command.value == 0) {
+                data.setContent(numRecord, content.toVector());
+                mCard->addChange(CardChange::ofRecord(file, i, 0, content.size()));
+                continue;
+            }
+
+            const size_t length = static_cast<size_t>(command.value);
+            data.setContent(numRecord, content.data() + offset, length, offset);
+            mCard->addChange(
+                command.type == CommandType::CACHED_BINARY
+                    ? CardChange::ofBinary(file, offset, length)
+                    : CardChange::ofRecord(file, i, offset, length));
+        }
+    }
+
+    /**
+     * Adds a read, merged into a previously prepared read when possible (see mergeRead()).
+     */
+    ReferenceTransactionManager&
+    addRead(Command&& read) {
+        if (mergeRead(read)) {
+            return *this;
+        }
+
+        if (read.type == CommandType::READ_BINARY && read.offset > 255) {
+            addBinaryFileSelection(read.sfi);
+        }
+
+        encodeRead(read);
+        mCommands.push_back(std::move(read));
+        notifyCommandPrepared();
+        return *this;
+    }
+
+    /**
+     * Merges the read into a prepared read of the same type and EF whose range (records or bytes)
+     * overlaps or is adjacent, when the merged read fits in a single APDU.
+     *
+     * <p>The search goes back over the other commands but stops at a session command or at a
+     * possible modification of the EF. Reads of an unknown current EF are never merged.
+     */
+    bool
+    mergeRead(const Command& read) {
+        /* The current EF may change between two reads of an unknown current EF */
+        if (read.sfi == 0) {
+            return false;
+        }
+
+        for (auto it = mCommands.rbegin(); it != mCommands.rend(); ++it) {
+            if (it->type == CommandType::OPEN_SESSION || it->type == CommandType::CLOSE_SESSION
+                || mayModify(*it, read.sfi)) {
+                return false;
+            }
+
+            if (it->type == read.type && it->sfi == read.sfi && merge(*it, read)) {
+                encodeRead(*it);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Merges the read into the provided read of the same type and EF if their ranges overlap or
+     * are adjacent and the merged read fits in a single APDU.
+     */
+    static bool
+    merge(Command& previous, const Command& read) {
+        switch (read.type) {
+        case CommandType::READ_RECORD:
+            /* Same record: a length of 0 reads the whole record */
+            if (previous.recordNumber != read.recordNumber) {
+                return false;
+            }
+
+            previous.value
+                = previous.value == 0 || read.value == 0 ? 0 : std::max(previous.value, read.value);
+            return true;
+        case CommandType::READ_RECORDS: {
+            const int from = std::min(previous.recordNumber, read.recordNumber);
+            const int to = std::max(previous.toRecordNumber, read.toRecordNumber);
+            if (previous.recordSize != read.recordSize
+                || !areContiguous(
+                    previous.recordNumber,
+                    previous.toRecordNumber + 1,
+                    read.recordNumber,
+                    read.toRecordNumber + 1)
+                || (to - from + 1) * (read.recordSize + 2) > PAYLOAD_CAPACITY) {
+                return false;
+            }
+
+            previous.recordNumber = from;
+            previous.toRecordNumber = to;
+            return true;
+        }
+        case CommandType::READ_PARTIALLY:
+        case CommandType::READ_BINARY: {
+            const int begin = std::min(previous.offset, read.offset);
+            const int end = std::max(previous.offset + previous.value, read.offset + read.value);
+            const int nbRecords = read.toRecordNumber - read.recordNumber + 1;
+            if (previous.recordNumber != read.recordNumber
+                || previous.toRecordNumber != read.toRecordNumber
+                || !areContiguous(
+                    previous.offset,
+                    previous.offset + previous.value,
+                    read.offset,
+                    read.offset + read.value)
+                || nbRecords * (end - begin) > PAYLOAD_CAPACITY) {
+                return false;
+            }
+
+            previous.offset = begin;
+            previous.value = end - begin;
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * Indicates whether the ranges [begin1, end1) and [begin2, end2) overlap or are adjacent.
+     */
+    static bool
+    areContiguous(const int begin1, const int end1, const int begin2, const int end2) {
+        return begin1 <= end2 && begin2 <= end1;
+    }
+
+    /**
+     * Builds the APDU of a read from its type, EF and range.
+     */
+    static void
+    encodeRead(Command& read) {
+        const uint8_t from = static_cast<uint8_t>(read.recordNumber);
+        const int nbRecords = read.toRecordNumber - read.recordNumber + 1;
+
+        switch (read.type) {
+        case CommandType::READ_RECORD:
+            read.apdu = {0x00,
+                         0xB2,
+                         from,
+                         static_cast<uint8_t>(read.sfi * 8 + 4),
+                         static_cast<uint8_t>(read.value)};
+            break;
+        case CommandType::READ_RECORDS:
+            read.apdu = {0x00,
+                         0xB2,
+                         from,
+                         static_cast<uint8_t>(read.sfi * 8 + 5),
+                         static_cast<uint8_t>(nbRecords * (read.recordSize + 2))};
+            break;
+        case CommandType::READ_PARTIALLY:
+            read.apdu = {0x00,
+                         0xB3,
+                         from,
+                         static_cast<uint8_t>(read.sfi * 8 + 5),
+                         0x04,
+                         0x54,
+                         0x02,
+                         static_cast<uint8_t>(read.offset),
+                         static_cast<uint8_t>(read.value),
+                         static_cast<uint8_t>(nbRecords * read.value)};
+            break;
+        default:
+            read.apdu = {0x00, 0xB0, 0x00, 0x00, static_cast<uint8_t>(read.value)};
+            encodeBinaryOffset(read.sfi, read.offset, read.apdu);
+            break;
+        }
+    }
+
+    /**
+     * Sets P1-P2 of a binary file command: the SFI and an offset in [0..255], or a 15-bit offset
+     * in the current EF beyond.
+     */
+    static void
+    encodeBinaryOffset(const uint8_t sfi, const int offset, std::vector<uint8_t>& apdu) {
+        if (offset > 255) {
+            apdu[2] = static_cast<uint8_t>(offset >> 8);
+            apdu[3] = static_cast<uint8_t>(offset);
+        } else {
+            apdu[2] = static_cast<uint8_t>(0x80 | sfi);
+            apdu[3] = static_cast<uint8_t>(offset);
+        }
+    }
+
+    /**
+     * Makes the binary EF the current EF before a command addressing an offset beyond 255, which
+     * cannot be encoded along with the SFI, by reading its first byte.
+     *
+     * <p>Nothing is added for an unknown current EF (SFI 0), which is already the current EF, or if
+     * the last prepared command already addresses this binary EF.
+     */
+    void
+    addBinaryFileSelection(const uint8_t sfi) {
+        if (sfi == 0) {
+            return;
+        }
+
+        if (!mCommands.empty() && mCommands.back().sfi == sfi
+            && (mCommands.back().type == CommandType::READ_BINARY
+                || mCommands.back().type == CommandType::UPDATE_BINARY
+                || mCommands.back().type == CommandType::WRITE_BINARY)) {
+            return;
+        }
+
+        Command selection = {CommandType::READ_BINARY, sfi, 1, 1, 0, 0, 1, 0, {}};
+        encodeRead(selection);
+        mCommands.push_back(std::move(selection));
+        notifyCommandPrepared();
+    }
+
+    void
+    checkNoAsyncProcessing() const {
+        if (mAsyncProcessing) {
+            throw std::logic_error("Asynchronous processing in progress");
+        }
+    }
+
+    void
+    startProcessing() {
+        mCard->clearChanges();
+
+        notify([](CardTransactionObserver& observer, const CardTransactionObserver::TimePoint t) {
+            observer.onProcessingStarted(t);
+        });
+    }
+
+    void
+    endProcessing() {
+        mCommands.clear();
+        mCachedReads.clear();
+        mSessionOpenAfterPreparedCommands = mSessionOpen;
+
+        notify([](CardTransactionObserver& observer, const CardTransactionObserver::TimePoint t) {
+            observer.onProcessingEnded(t);
+        });
+    }
+
+    /**
+     * Submits the step processing the command at the provided index, or ending the processing
+     * once all the commands have been processed.
+     */
+    void
+    submitStep(
+        const size_t index,
+        const std::shared_ptr<CardTransactionExecutor> executor,
+        const std::function<void(const std::exception_ptr)> completionCallback) {
+        executor->execute([this, index, executor, completionCallback]() {
+            if (index < mCommands.size()) {
+                try {
+                    processCommand(mCommands[index]);
+                } catch (...) {
+                    mCurrentSfi = 0;
+                    endProcessing();
+                    mAsyncProcessing = false;
+                    completionCallback(std::current_exception());
+                    return;
+                }
+
+                submitStep(index + 1, executor, completionCallback);
+                return;
+            }
+
+            endProcessing();
+            mAsyncProcessing = false;
+            completionCallback(nullptr);
+        });
+    }
+
+    static const std::string&
+    getCommandName(const uint8_t ins) {
+        static const std::string names[] = {"SELECT FILE",
+                                            "GET DATA",
+                                            "READ RECORD",
+                                            "READ RECORD MULTIPLE",
+                                            "READ BINARY",
+                                            "SEARCH RECORD MULTIPLE",
+                                            "VERIFY PIN",
+                                            "CHANGE PIN",
+                                            "APPEND RECORD",
+                                            "UPDATE RECORD",
+                                            "WRITE RECORD",
+                                            "UPDATE BINARY",
+                                            "WRITE BINARY",
+                                            "INCREASE",
+                                            "DECREASE",
+                                            "OPEN SECURE SESSION",
+                                            "CLOSE SECURE SESSION",
+                                            "SV GET",
+                                            "SV RELOAD",
+                                            "SV DEBIT",
+                                            "UNKNOWN"};
+        static const uint8_t instructions[] = {0xA4, 0xCA, 0xB2, 0xB3, 0xB0, 0xA2, 0x20,
+                                               0xD8, 0xE2, 0xDC, 0xD2, 0xD6, 0xD0, 0x32,
+                                               0x30, 0x8A, 0x8E, 0x7C, 0xB8, 0xBA};
+        size_t i = 0;
+        while (i < sizeof(instructions) && instructions[i] != ins) {
+            i++;
+        }
+
+        return names[i];
+    }
+
+    template <typename F>
+    void
+    notify(const F& notification) {
+        if (!mObserver) {
+            return;
+        }
+
+        try {
+            notification(*mObserver, std::chrono::steady_clock::now());
+        } catch (...) {
+            /* Observer exceptions are ignored */
+        }
+    }
+
+    void
+    notifyCommandPrepared() {
+        const std::string& name = getCommandName(mCommands.back().apdu[1]);
+        notify([&name](CardTransactionObserver& observer,
+                       const CardTransactionObserver::TimePoint t) {
+            observer.onCommandPrepared(t, name);
+        });
+    }
+
+    void
+    processCommand(const Command& command) {
+        if (isCachedRead(command.type)) {
+            applyCachedRead(command);
+            return;
+        }
+
+        if (!mSimulatedCardReader) {
+            static const std::vector<uint8_t> successResponse = {0x90, 0x00};
+            recordAuditData(command.apdu, successResponse);
+            apply(command);
+            return;
+        }
+
+        notify([&command](
+                   CardTransactionObserver& observer, const CardTransactionObserver::TimePoint t) {
+            observer.onApduSent(t, command.apdu);
+        });
+        const std::vector<uint8_t> response = mSimulatedCardReader->transmitApdu(command.apdu);
+        notify([&response](
+                   CardTransactionObserver& observer, const CardTransactionObserver::TimePoint t) {
+            observer.onApduReceived(t, response);
+        });
+        recordAuditData(command.apdu, response);
+
+        const size_t length = response.size() - 2;
+        if (response[length] != 0x90 || response[length + 1] != 0x00) {
+            throw UnexpectedCommandStatusException("Unexpected status word");
+        }
+
+        applyResponse(command, response.data(), length);
+        apply(command);
+    }
+
+    void
+    recordAuditData(const std::vector<uint8_t>& command, const std::vector<uint8_t>& response) {
+        if (mAuditSink) {
+            mAuditSink->onApduExchange(TransactionAuditSink::Source::CARD, command, response);
+        }
+
+        if (mAuditDataMaxSize == 0) {
+            return;
+        }
+
+        mAuditData.push_back(command);
+        mAuditData.push_back(response);
+        mAuditDataSize += command.size() + response.size();
+        discardOldestAuditData();
+    }
+
+    /**
+     * Discards the oldest exchanges (command and response) until the retained size fits the
+     * limit.
+     *
+     * <p>The discarded entries are only skipped by moving the head index: the vector is compacted
+     * once they make up more than half of it, so that each entry is moved at most once on average.
+     */
+    void
+    discardOldestAuditData() {
+        while (mAuditDataSize > mAuditDataMaxSize && mAuditDataHead < mAuditData.size()) {
+            mAuditDataSize
+                -= mAuditData[mAuditDataHead].size() + mAuditData[mAuditDataHead + 1].size();
+            mAuditDataHead += 2;
+        }
+
+        if (mAuditDataHead * 2 > mAuditData.size()) {
+            compactAuditData();
+        }
+    }
+
+    void
+    compactAuditData() const {
+        if (mAuditDataHead > 0) {
+            mAuditData.erase(mAuditData.begin(), mAuditData.begin() + mAuditDataHead);
+            mAuditDataHead = 0;
+        }
+    }
+
+    static int
+    readInt(const uint8_t* in, const size_t size) {
+        int value = 0;
+        for (size_t i = 0; i < size; i++) {
+            value = (value << 8) | in[i];
+        }
+
+        return value;
+    }
+
+    void
+    applyResponse(const Command& command, const uint8_t* response, const size_t length) {
+        /* The data read from an unknown current EF cannot be keyed in the card image */
+        if (command.sfi == 0 && isRead(command.type)) {
+            return;
+        }
+
+        switch (command.type) {
+        case CommandType::READ_RECORD:
+            /* A read limited by Le (value) only returns the beginning of the record */
+            if (command.value == 0) {
+                mCard->getOrCreateFile(command.sfi)
+                    .getMutableData()
+                    .setContent(
+                        static_cast<uint8_t>(command.recordNumber),
+                        std::vector<uint8_t>(response, response + length));
+            } else {
+                mCard->getOrCreateFile(command.sfi)
+                    .getMutableData()
+                    .setContent(static_cast<uint8_t>(command.recordNumber), response, length, 0);
+            }
+            mCard->addChange(CardChange::ofRecord(
+                FileKey::ofSfi(command.sfi), command.recordNumber, 0, length));
+            break;
+        case CommandType::READ_RECORDS: {
+            ReferenceFileData& data = mCard->getOrCreateFile(command.sfi).getMutableData();
+            size_t i = 0;
+            while (i + 2 <= length && i + 2 + response[i + 1] <= length) {
+                data.setContent(
+                    response[i],
+                    std::vector<uint8_t>(response + i + 2, response + i + 2 + response[i + 1]));
+                mCard->addChange(CardChange::ofRecord(
+                    FileKey::ofSfi(command.sfi), response[i], 0, response[i + 1]));
+                i += 2 + response[i + 1];
+            }
+            break;
+        }
+        case CommandType::READ_PARTIALLY: {
+            ReferenceFileData& data = mCard->getOrCreateFile(command.sfi).getMutableData();
+            const size_t partSize = static_cast<size_t>(command.value);
+            size_t i = 0;
+            for (int record = command.recordNumber;
+                 record <= command.toRecordNumber && i + partSize <= length;
+                 record++) {
+                data.setContent(
+                    static_cast<uint8_t>(record),
+                    response + i,
+                    partSize,
+                    static_cast<size_t>(command.offset));
+                mCard->addChange(CardChange::ofRecord(
+                    FileKey::ofSfi(command.sfi),
+                    record,
+                    static_cast<size_t>(command.offset),
+                    partSize));
+                i += partSize;
+            }
+            break;
+        }
+        case CommandType::READ_BINARY:
+            mCard->getOrCreateFile(command.sfi)
+                .getMutableData()
+                .setContent(1, response, length, static_cast<size_t>(command.offset));
+            mCard->addChange(CardChange::ofBinary(
+                FileKey::ofSfi(command.sfi), static_cast<size_t>(command.offset), length));
+            break;
+        case CommandType::OPEN_SESSION:
+            if (length >= 3) {
+                mCard->setTransactionCounter(readInt(response, 3));
+                mSessionCounterReported = true;
+                mCardImageCacheUsable = true;
+            }
+            break;
+        case CommandType::SV_GET:
+            if (length >= 46) {
+                mCard->setSvData(
+                    readInt(response + 2, 3) - ((response[2] & 0x80) != 0 ? 0x1000000 : 0),
+                    readInt(response, 2),
+                    std::vector<uint8_t>(response + 5, response + 27),
+                    {std::vector<uint8_t>(response + 27, response + 46)});
+                mCard->addChange(CardChange::ofRecord(FileKey::svLoadLog(), 1, 0, 22));
+                mCard->addChange(CardChange::ofRecord(FileKey::svDebitLog(), 1, 0, 19));
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    void
+    apply(const Command& command) {
+        if (command.type == CommandType::OPEN_SESSION) {
+            mSessionOpen = true;
+            notify([](CardTransactionObserver& observer,
+                      const CardTransactionObserver::TimePoint t) { observer.onSessionOpened(t); });
+            return;
+        }
+
+        if (command.type == CommandType::CLOSE_SESSION) {
+            mSessionOpen = false;
+            const bool cancelled = command.apdu[4] == 0x00;
+            /* The next opening reports the counter decremented once more */
+            if (!cancelled && mSessionCounterReported && mCardImageCache && !mCardImageStale) {
+                mCardImageCache->put(
+                    mCard->getApplicationSerialNumber(),
+                    mCard->getTransactionCounter() - 1,
+                    mCard->getCardImage());
+            }
+            mSessionCounterReported = false;
+            mCardImageCacheUsable = false;
+            notify([cancelled](
+                       CardTransactionObserver& observer,
+                       const CardTransactionObserver::TimePoint t) {
+                observer.onSessionClosed(t, cancelled);
+            });
+            return;
+        }
+
+        if (!isModification(command.type)) {
+            return;
+        }
+
+        /* The cached image no longer matches the card */
+        mCardImageCacheUsable = false;
+        if (command.sfi == 0) {
+            /* Any EF may have been modified: the card image no longer reflects the card */
+            mCardImageStale = true;
+            if (!mSessionOpen && mCardImageCache) {
+                mCardImageCache->remove(mCard->getApplicationSerialNumber());
+            }
+            return;
+        }
+
+        const FileKey file = FileKey::ofSfi(command.sfi);
+        if (!mSessionOpen && mCardImageCache && mCardImageCache->isCacheable(file)) {
+            mCardImageCache->remove(mCard->getApplicationSerialNumber());
+        }
+
+        ReferenceFileData& data = mCard->getOrCreateFile(command.sfi).getMutableData();
+        const uint8_t* content = command.apdu.data() + command.dataOffset;
+        const size_t length = command.apdu.size() - command.dataOffset;
+        const uint8_t recordNumber = static_cast<uint8_t>(command.recordNumber);
+
+        switch (command.type) {
+        case CommandType::APPEND_RECORD:
+            data.addCyclicContent(content, length);
+            mCard->addChange(CardChange::ofRecord(file, 1, 0, length));
+            break;
+        case CommandType::UPDATE_RECORD:
+            data.setContent(recordNumber, content, length, 0);
+            mCard->addChange(CardChange::ofRecord(file, recordNumber, 0, length));
+            break;
+        case CommandType::WRITE_RECORD:
+            data.fillContent(recordNumber, content, length, 0);
+            mCard->addChange(CardChange::ofRecord(file, recordNumber, 0, length));
+            break;
+        case CommandType::UPDATE_BINARY:
+        case CommandType::WRITE_BINARY: {
+            const size_t offset = static_cast<size_t>(command.offset);
+            if (command.type == CommandType::UPDATE_BINARY) {
+                data.setContent(1, content, length, offset);
+            } else {
+                data.fillContent(1, content, length, offset);
+            }
+            mCard->addChange(CardChange::ofBinary(file, offset, length));
+            break;
+        }
+        case CommandType::INCREASE:
+        case CommandType::DECREASE: {
+            const int counterNumber = command.recordNumber == 0 ? 1 : command.recordNumber;
+            /* A counter whose value was not read remains unknown */
+            if (mCard->getCardImage().isKnown(
+                    file, 1, static_cast<size_t>(3 * (counterNumber - 1)), 3)) {
+                const int oldValue = data.getCounterValues().getValue(counterNumber).orElse(0);
+                const int newValue = command.type == CommandType::INCREASE
+                                         ? oldValue + command.value
+                                         : oldValue - command.value;
+                data.setCounter(counterNumber, newValue & 0xFFFFFF);
+            }
+            mCard->addChange(CardChange::ofCounter(file, counterNumber));
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    std::shared_ptr<CardReader> mCardReader;
+    std::shared_ptr<SimulatedCardReader> mSimulatedCardReader;
+    std::shared_ptr<ReferenceCalypsoCard> mCard;
+    std::vector<Command> mCommands;
+    uint8_t mCurrentSfi;
+    mutable std::vector<std::vector<uint8_t>> mAuditData;
+    mutable size_t mAuditDataHead;
+    size_t mAuditDataSize;
+    size_t mAuditDataMaxSize;
+    std::shared_ptr<TransactionAuditSink> mAuditSink;
+    std::shared_ptr<CardTransactionObserver> mObserver;
+    bool mCachedReadsSkipping;
+    std::shared_ptr<CardImageCache> mCardImageCache;
+    CardImage mCachedReads;
+    bool mSessionCounterReported;
+    bool mCardImageCacheUsable;
+    bool mCardImageStale;
+    bool mSessionOpen;
+    bool mSessionOpenAfterPreparedCommands;
+    std::atomic<bool> mAsyncProcessing;
+};
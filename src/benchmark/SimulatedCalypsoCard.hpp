@@ -0,0 +1,680 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/**
+ * Software emulation of a Calypso card processing APDUs.
+ *
+ * <p>The emulator handles SELECT FILE, GET DATA, READ RECORD(S), READ BINARY, UPDATE/WRITE/APPEND
+ * RECORD, UPDATE/WRITE BINARY, INCREASE/DECREASE (single and multiple), VERIFY PIN, GET CHALLENGE,
+ * OPEN/CLOSE SECURE SESSION, SV GET, SV RELOAD and SV DEBIT.
+ *
+ * <p>It is intended for load testing only: no cryptographic computation is done (signatures are
+ * constant) and the SV commands use a simplified data layout (see processSv()). Modifications made
+ * inside a secure session are cancelled if the session is aborted (CLOSE SECURE SESSION with no
+ * data) or if a new session is opened while one is still open.
+ *
+ * <p>A configurable latency is applied to each APDU to mimic the card and the RF link.
+ */
+class SimulatedCalypsoCard final {
+public:
+    /**
+     * Status word returned on success.
+     */
+    static const uint16_t SW_SUCCESS = 0x9000;
+
+    SimulatedCalypsoCard()
+    : mApduLatency(0)
+    , mCurrentSfi(0)
+    , mTransactionCounter(0xFFFFFF)
+    , mSessionOpen(false)
+    , mSvBalance(0)
+    , mSvTNum(0)
+    , mSvLoadLog(SV_LOAD_LOG_SIZE, 0x00)
+    , mBackupSvBalance(0)
+    , mBackupSvTNum(0)
+    , mApduCount(0) {
+    }
+
+    /**
+     * Sets the latency applied to each APDU (default: none).
+     */
+    void
+    setApduLatency(const std::chrono::microseconds apduLatency) {
+        mApduLatency = apduLatency;
+    }
+
+    /**
+     * Creates (or recreates) a file with the provided number of records filled with zeros.
+     */
+    void
+    addFile(const uint8_t sfi, const int recordsNumber, const int recordSize) {
+        if (sfi == 0 || sfi > 30 || recordsNumber < 1 || recordSize < 1) {
+            throw std::invalid_argument("file");
+        }
+
+        mFiles[sfi] = Records(
+            static_cast<size_t>(recordsNumber),
+            std::vector<uint8_t>(static_cast<size_t>(recordSize), 0x00));
+    }
+
+    /**
+     * Sets the content of a record of an existing file.
+     */
+    void
+    setRecord(const uint8_t sfi, const int recordNumber, const std::vector<uint8_t>& content) {
+        std::vector<uint8_t>* record = findRecord(sfi, recordNumber);
+        if (record == nullptr) {
+            throw std::invalid_argument("record");
+        }
+
+        const size_t length = std::min(content.size(), record->size());
+        std::copy(content.begin(), content.begin() + length, record->begin());
+    }
+
+    /**
+     * Sets the SV balance.
+     */
+    void
+    setSvBalance(const int svBalance) {
+        mSvBalance = svBalance;
+    }
+
+    /**
+     * Gets the SV balance.
+     */
+    int
+    getSvBalance() const {
+        return mSvBalance;
+    }
+
+    /**
+     * Sets the transaction counter (default: FFFFFFh), decremented at each session opening.
+     */
+    void
+    setTransactionCounter(const int transactionCounter) {
+        mTransactionCounter = transactionCounter;
+    }
+
+    /**
+     * Gets the current transaction counter.
+     */
+    int
+    getTransactionCounter() const {
+        return mTransactionCounter;
+    }
+
+    /**
+     * Indicates whether a secure session is open.
+     */
+    bool
+    isSessionOpen() const {
+        return mSessionOpen;
+    }
+
+    /**
+     * Gets the number of APDUs processed since the creation of the card.
+     */
+    uint64_t
+    getApduCount() const {
+        return mApduCount;
+    }
+
+    /**
+     * Processes an APDU (case 1 to 4, short length) and returns the response including the status
+     * word.
+     */
+    std::vector<uint8_t>
+    processApdu(const std::vector<uint8_t>& apdu) {
+        mApduCount++;
+
+        if (mApduLatency.count() > 0) {
+            std::this_thread::sleep_for(mApduLatency);
+        }
+
+        std::vector<uint8_t> response;
+        if (apdu.size() < 4) {
+            return withStatus(response, 0x6700);
+        }
+
+        const Apdu command(apdu);
+        uint16_t sw;
+
+        switch (command.ins) {
+        case 0xA4:
+            response = {0x85, 0x17, 0x00, 0x00, 0x00, 0x00, 0x00};
+            sw = SW_SUCCESS;
+            break;
+        case 0xCA:
+            sw = 0x6A88;
+            break;
+        case 0xB2:
+            sw = processReadRecord(command, response);
+            break;
+        case 0xB3:
+            sw = processReadRecordsPartially(command, response);
+            break;
+        case 0xB0:
+            sw = processReadBinary(command, response);
+            break;
+        case 0xDC:
+        case 0xD2:
+            sw = processUpdateRecord(command);
+            break;
+        case 0xE2:
+            sw = processAppendRecord(command);
+            break;
+        case 0xD6:
+        case 0xD0:
+            sw = processUpdateBinary(command);
+            break;
+        case 0x32:
+        case 0x30:
+            sw = processCounter(command, response);
+            break;
+        case 0x3A:
+        case 0x38:
+            sw = processCounters(command, response);
+            break;
+        case 0x20:
+            sw = SW_SUCCESS;
+            break;
+        case 0x84:
+            response.assign(8, 0x5A);
+            sw = SW_SUCCESS;
+            break;
+        case 0x8A:
+            sw = processOpenSession(command, response);
+            break;
+        case 0x8E:
+            sw = processCloseSession(command, response);
+            break;
+        case 0x7C:
+        case 0xB8:
+        case 0xBA:
+            sw = processSv(command, response);
+            break;
+        default:
+            sw = 0x6D00;
+            break;
+        }
+
+        return withStatus(response, sw);
+    }
+
+private:
+    using Records = std::vector<std::vector<uint8_t>>;
+
+    static const size_t SV_LOAD_LOG_SIZE = 22;
+    static const size_t SV_DEBIT_LOG_SIZE = 19;
+    static const size_t SV_DEBIT_LOGS_COUNT = 3;
+
+    /**
+     * Decoded view of a command APDU.
+     */
+    struct Apdu {
+        explicit Apdu(const std::vector<uint8_t>& apdu)
+        : ins(apdu[1]), p1(apdu[2]), p2(apdu[3]), data(apdu.data() + 5), dataLength(0), le(0) {
+            if (apdu.size() > 5 && static_cast<size_t>(apdu[4]) + 5 <= apdu.size()) {
+                dataLength = apdu[4];
+                if (apdu.size() == dataLength + 6) {
+                    le = apdu.back();
+                }
+            } else if (apdu.size() == 5) {
+                le = apdu[4];
+            }
+        }
+
+        uint8_t ins;
+        uint8_t p1;
+        uint8_t p2;
+        const uint8_t* data;
+        size_t dataLength;
+        size_t le;
+    };
+
+    static std::vector<uint8_t>
+    withStatus(std::vector<uint8_t>& response, const uint16_t sw) {
+        response.push_back(static_cast<uint8_t>(sw >> 8));
+        response.push_back(static_cast<uint8_t>(sw));
+        return std::move(response);
+    }
+
+    static void
+    appendInt(std::vector<uint8_t>& out, const int value, const size_t size) {
+        for (size_t i = size; i > 0; i--) {
+            out.push_back(static_cast<uint8_t>(value >> (8 * (i - 1))));
+        }
+    }
+
+    static int
+    readInt(const uint8_t* in, const size_t size) {
+        int value = 0;
+        for (size_t i = 0; i < size; i++) {
+            value = (value << 8) | in[i];
+        }
+
+        return value;
+    }
+
+    std::vector<uint8_t>*
+    findRecord(const uint8_t sfi, const int recordNumber) {
+        const auto it = mFiles.find(sfi);
+        if (it == mFiles.end() || recordNumber < 1
+            || static_cast<size_t>(recordNumber) > it->second.size()) {
+            return nullptr;
+        }
+
+        return &it->second[static_cast<size_t>(recordNumber - 1)];
+    }
+
+    uint16_t
+    processReadRecord(const Apdu& command, std::vector<uint8_t>& response) {
+        const uint8_t sfi = command.p2 >> 3;
+        const auto it = mFiles.find(sfi);
+        if (it == mFiles.end()) {
+            return 0x6A82;
+        }
+
+        if ((command.p2 & 0x07) == 0x04) {
+            const std::vector<uint8_t>* record = findRecord(sfi, command.p1);
+            if (record == nullptr) {
+                return 0x6A83;
+            }
+
+            response = *record;
+            return SW_SUCCESS;
+        }
+
+        /* Multiple records: record number, length, data, within the expected length */
+        const size_t expectedLength = command.le != 0 ? command.le : 256;
+        for (size_t i = command.p1; i <= it->second.size(); i++) {
+            const std::vector<uint8_t>& record = it->second[i - 1];
+            if (response.size() + 2 + record.size() > expectedLength) {
+                break;
+            }
+
+            response.push_back(static_cast<uint8_t>(i));
+            response.push_back(static_cast<uint8_t>(record.size()));
+            response.insert(response.end(), record.begin(), record.end());
+        }
+
+        return response.empty() ? 0x6A83 : SW_SUCCESS;
+    }
+
+    uint16_t
+    processReadRecordsPartially(const Apdu& command, std::vector<uint8_t>& response) {
+        const auto it = mFiles.find(command.p2 >> 3);
+        if (it == mFiles.end()) {
+            return 0x6A82;
+        }
+
+        if (command.dataLength != 4 || command.data[0] != 0x54) {
+            return 0x6A80;
+        }
+
+        /* Same part of each record, within the expected length */
+        const size_t offset = command.data[2];
+        const size_t length = command.data[3];
+        const size_t expectedLength = command.le != 0 ? command.le : 256;
+        for (size_t i = command.p1;
+             i <= it->second.size() && response.size() + length <= expectedLength;
+             i++) {
+            const std::vector<uint8_t>& record = it->second[i - 1];
+            if (offset + length > record.size()) {
+                return 0x6B00;
+            }
+
+            response.insert(
+                response.end(), record.begin() + offset, record.begin() + offset + length);
+        }
+
+        return response.empty() ? 0x6A83 : SW_SUCCESS;
+    }
+
+    /**
+     * Resolves the EF and the offset of a binary file command: P1 holds the SFI (b8 set) and P2
+     * an offset in [0..255], or P1-P2 hold a 15-bit offset in the current EF.
+     */
+    std::vector<uint8_t>*
+    findBinaryContent(const Apdu& command, size_t& offset) {
+        if ((command.p1 & 0x80) != 0) {
+            mCurrentSfi = command.p1 & 0x1F;
+            offset = command.p2;
+        } else {
+            offset = (static_cast<size_t>(command.p1) << 8) | command.p2;
+        }
+
+        return findRecord(mCurrentSfi, 1);
+    }
+
+    uint16_t
+    processReadBinary(const Apdu& command, std::vector<uint8_t>& response) {
+        size_t offset;
+        const std::vector<uint8_t>* content = findBinaryContent(command, offset);
+        if (content == nullptr) {
+            return 0x6A82;
+        }
+
+        if (offset >= content->size()) {
+            return 0x6B00;
+        }
+
+        const size_t expectedLength = command.le != 0 ? command.le : 256;
+        const size_t length = std::min(expectedLength, content->size() - offset);
+        response.assign(content->begin() + offset, content->begin() + offset + length);
+        return SW_SUCCESS;
+    }
+
+    uint16_t
+    processUpdateRecord(const Apdu& command) {
+        std::vector<uint8_t>* record = findRecord(command.p2 >> 3, command.p1);
+        if (record == nullptr) {
+            return 0x6A83;
+        }
+
+        if (command.dataLength > record->size()) {
+            return 0x6700;
+        }
+
+        for (size_t i = 0; i < command.dataLength; i++) {
+            uint8_t& b = (*record)[i];
+            b = command.ins == 0xDC ? command.data[i] : static_cast<uint8_t>(b | command.data[i]);
+        }
+
+        return SW_SUCCESS;
+    }
+
+    uint16_t
+    processAppendRecord(const Apdu& command) {
+        const auto it = mFiles.find(command.p2 >> 3);
+        if (it == mFiles.end()) {
+            return 0x6A82;
+        }
+
+        Records& records = it->second;
+        if (command.dataLength > records.front().size()) {
+            return 0x6700;
+        }
+
+        std::rotate(records.rbegin(), records.rbegin() + 1, records.rend());
+        std::fill(records.front().begin(), records.front().end(), 0x00);
+        std::copy(command.data, command.data + command.dataLength, records.front().begin());
+
+        return SW_SUCCESS;
+    }
+
+    uint16_t
+    processUpdateBinary(const Apdu& command) {
+        size_t offset;
+        std::vector<uint8_t>* content = findBinaryContent(command, offset);
+        if (content == nullptr) {
+            return 0x6A82;
+        }
+
+        if (offset + command.dataLength > content->size()) {
+            return 0x6B00;
+        }
+
+        for (size_t i = 0; i < command.dataLength; i++) {
+            uint8_t& b = (*content)[offset + i];
+            b = command.ins == 0xD6 ? command.data[i] : static_cast<uint8_t>(b | command.data[i]);
+        }
+
+        return SW_SUCCESS;
+    }
+
+    uint16_t
+    applyCounter(
+        const uint8_t sfi,
+        const int counterNumber,
+        const bool increase,
+        const int value,
+        int& newValue) {
+        std::vector<uint8_t>* record = findRecord(sfi, 1);
+        if (record == nullptr) {
+            return 0x6A82;
+        }
+
+        const size_t offset = static_cast<size_t>(counterNumber - 1) * 3;
+        if (counterNumber < 1 || offset + 3 > record->size()) {
+            return 0x6A83;
+        }
+
+        const int oldValue = readInt(record->data() + offset, 3);
+        newValue = increase ? oldValue + value : oldValue - value;
+        if (newValue < 0 || newValue > 0xFFFFFF) {
+            return 0x6400;
+        }
+
+        for (size_t i = 0; i < 3; i++) {
+            (*record)[offset + i] = static_cast<uint8_t>(newValue >> (8 * (2 - i)));
+        }
+
+        return SW_SUCCESS;
+    }
+
+    uint16_t
+    processCounter(const Apdu& command, std::vector<uint8_t>& response) {
+        if (command.dataLength != 3) {
+            return 0x6700;
+        }
+
+        int newValue = 0;
+        const uint16_t sw = applyCounter(
+            command.p2 >> 3,
+            command.p1 == 0 ? 1 : command.p1,
+            command.ins == 0x32,
+            readInt(command.data, 3),
+            newValue);
+        if (sw == SW_SUCCESS) {
+            appendInt(response, newValue, 3);
+        }
+
+        return sw;
+    }
+
+    uint16_t
+    processCounters(const Apdu& command, std::vector<uint8_t>& response) {
+        if (command.dataLength == 0 || command.dataLength % 4 != 0) {
+            return 0x6700;
+        }
+
+        for (size_t i = 0; i < command.dataLength; i += 4) {
+            int newValue = 0;
+            const uint16_t sw = applyCounter(
+                command.p2 >> 3,
+                command.data[i],
+                command.ins == 0x3A,
+                readInt(command.data + i + 1, 3),
+                newValue);
+            if (sw != SW_SUCCESS) {
+                response.clear();
+                return sw;
+            }
+
+            response.push_back(command.data[i]);
+            appendInt(response, newValue, 3);
+        }
+
+        return SW_SUCCESS;
+    }
+
+    uint16_t
+    processOpenSession(const Apdu& command, std::vector<uint8_t>& response) {
+        if (mSessionOpen) {
+            rollback();
+        }
+
+        if (mTransactionCounter == 0) {
+            return 0x6985;
+        }
+
+        mSessionOpen = true;
+        mBackupFiles = mFiles;
+        mBackupSvBalance = mSvBalance;
+        mBackupSvTNum = mSvTNum;
+        mBackupSvLoadLog = mSvLoadLog;
+        mBackupSvDebitLogs = mSvDebitLogs;
+        mTransactionCounter--;
+
+        /* Transaction counter, random, ratification, KIF, KVC, record data length */
+        appendInt(response, mTransactionCounter, 3);
+        response.push_back(0x5A);
+        response.push_back(0x00);
+        response.push_back(0x00);
+        response.push_back(0x21);
+        response.push_back(0x79);
+
+        const std::vector<uint8_t>* record = findRecord(command.p2 >> 3, command.p1 >> 3);
+        if (record == nullptr) {
+            response.push_back(0x00);
+        } else {
+            response.push_back(static_cast<uint8_t>(record->size()));
+            response.insert(response.end(), record->begin(), record->end());
+        }
+
+        return SW_SUCCESS;
+    }
+
+    uint16_t
+    processCloseSession(const Apdu& command, std::vector<uint8_t>& response) {
+        if (!mSessionOpen) {
+            return 0x6985;
+        }
+
+        mSessionOpen = false;
+
+        if (command.dataLength == 0) {
+            /* Abort */
+            rollback();
+            return SW_SUCCESS;
+        }
+
+        mBackupFiles.clear();
+        mBackupSvDebitLogs.clear();
+        response.assign(4, 0xC5);
+
+        return SW_SUCCESS;
+    }
+
+    /**
+     * Simplified SV commands:
+     * <ul>
+     *   <li>SV GET returns SV TNum (2), balance (3), load log (22) and last debit log (19).
+     *   <li>SV RELOAD data starts with a signed amount (3), SV DEBIT data with an amount (2),
+     *       both followed by a date (2) and a time (2).
+     * </ul>
+     * SV RELOAD and SV DEBIT require an open secure session.
+     */
+    uint16_t
+    processSv(const Apdu& command, std::vector<uint8_t>& response) {
+        if (command.ins == 0x7C) {
+            appendInt(response, mSvTNum, 2);
+            appendInt(response, mSvBalance, 3);
+            response.insert(response.end(), mSvLoadLog.begin(), mSvLoadLog.end());
+            if (mSvDebitLogs.empty()) {
+                response.insert(response.end(), SV_DEBIT_LOG_SIZE, 0x00);
+            } else {
+                response.insert(
+                    response.end(), mSvDebitLogs.front().begin(), mSvDebitLogs.front().end());
+            }
+
+            return SW_SUCCESS;
+        }
+
+        if (!mSessionOpen) {
+            return 0x6985;
+        }
+
+        const bool reload = command.ins == 0xB8;
+        const size_t amountSize = reload ? 3 : 2;
+        if (command.dataLength < amountSize + 4) {
+            return 0x6700;
+        }
+
+        int amount = readInt(command.data, amountSize);
+        if (reload && (amount & 0x800000) != 0) {
+            amount -= 0x1000000;
+        }
+
+        const int newBalance = reload ? mSvBalance + amount : mSvBalance - amount;
+        if (newBalance < -0x800000 || newBalance > 0x7FFFFF) {
+            return 0x6400;
+        }
+
+        mSvBalance = newBalance;
+        mSvTNum = (mSvTNum + 1) & 0xFFFF;
+
+        std::vector<uint8_t> log;
+        if (reload) {
+            /* Date, free, KVC, free, balance, amount, time, SAM ID, SAM TNum, SV TNum */
+            log.insert(log.end(), command.data + amountSize, command.data + amountSize + 2);
+            log.insert(log.end(), {0x00, 0x79, 0x00});
+            appendInt(log, mSvBalance, 3);
+            appendInt(log, amount, 3);
+            log.insert(log.end(), command.data + amountSize + 2, command.data + amountSize + 4);
+            log.insert(log.end(), 7, 0x00);
+            appendInt(log, mSvTNum, 2);
+            mSvLoadLog = log;
+        } else {
+            /* Amount, date, time, KVC, SAM ID, SAM TNum, balance, SV TNum */
+            appendInt(log, amount, 2);
+            log.insert(log.end(), command.data + amountSize, command.data + amountSize + 4);
+            log.push_back(0x79);
+            log.insert(log.end(), 7, 0x00);
+            appendInt(log, mSvBalance, 3);
+            appendInt(log, mSvTNum, 2);
+            mSvDebitLogs.insert(mSvDebitLogs.begin(), log);
+            if (mSvDebitLogs.size() > SV_DEBIT_LOGS_COUNT) {
+                mSvDebitLogs.pop_back();
+            }
+        }
+
+        response.assign(3, 0x5C);
+
+        return SW_SUCCESS;
+    }
+
+    void
+    rollback() {
+        mFiles = mBackupFiles;
+        mSvBalance = mBackupSvBalance;
+        mSvTNum = mBackupSvTNum;
+        mSvLoadLog = mBackupSvLoadLog;
+        mSvDebitLogs = mBackupSvDebitLogs;
+        mBackupFiles.clear();
+        mSessionOpen = false;
+    }
+
+    std::chrono::microseconds mApduLatency;
+    std::map<uint8_t, Records> mFiles;
+    uint8_t mCurrentSfi;
+    int mTransactionCounter;
+    bool mSessionOpen;
+    int mSvBalance;
+    int mSvTNum;
+    std::vector<uint8_t> mSvLoadLog;
+    std::vector<std::vector<uint8_t>> mSvDebitLogs;
+    std::map<uint8_t, Records> mBackupFiles;
+    int mBackupSvBalance;
+    int mBackupSvTNum;
+    std::vector<uint8_t> mBackupSvLoadLog;
+    std::vector<std::vector<uint8_t>> mBackupSvDebitLogs;
+    uint64_t mApduCount;
+};
@@ -0,0 +1,301 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+/* Keypop Calypso Card */
+#include "keypop/calypso/card/transaction/spi/CardTransactionObserver.hpp"
+
+/* Benchmark */
+#include "ReferenceTransactionManager.hpp"
+#include "SimulatedCalypsoCard.hpp"
+#include "SimulatedCardReader.hpp"
+
+namespace {
+
+const uint8_t SFI_ENVIRONMENT = 0x07;
+const uint8_t SFI_EVENTS_LOG = 0x08;
+const uint8_t SFI_CONTRACTS = 0x09;
+const uint8_t SFI_COUNTERS = 0x19;
+
+std::shared_ptr<SimulatedCalypsoCard>
+createSimulatedCard(const int64_t apduLatencyMicros) {
+    const auto card = std::make_shared<SimulatedCalypsoCard>();
+    card->setApduLatency(std::chrono::microseconds(apduLatencyMicros));
+    card->addFile(SFI_ENVIRONMENT, 1, 29);
+    card->addFile(SFI_EVENTS_LOG, 3, 29);
+    card->addFile(SFI_CONTRACTS, 4, 29);
+    card->addFile(SFI_COUNTERS, 1, 27);
+    card->setRecord(SFI_ENVIRONMENT, 1, std::vector<uint8_t>(29, 0xE0));
+    for (int i = 1; i <= 4; i++) {
+        card->setRecord(SFI_CONTRACTS, i, std::vector<uint8_t>(29, static_cast<uint8_t>(i)));
+    }
+    card->setRecord(SFI_COUNTERS, 1, std::vector<uint8_t>(27, 0x10));
+    card->setSvBalance(0x7FFFFF);
+
+    return card;
+}
+
+/**
+ * Reports the median and the 99th percentile of the provided durations (in microseconds, averaged
+ * over the threads) and the number of transactions per second (summed over the threads).
+ */
+void
+reportLatencies(benchmark::State& state, std::vector<double>& latencies) {
+    if (latencies.empty()) {
+        return;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    state.counters["p50_us"]
+        = benchmark::Counter(latencies[latencies.size() / 2], benchmark::Counter::kAvgThreads);
+    state.counters["p99_us"] = benchmark::Counter(
+        latencies[latencies.size() * 99 / 100], benchmark::Counter::kAvgThreads);
+    state.counters["tps"] = benchmark::Counter(
+        static_cast<double>(latencies.size()), benchmark::Counter::kIsRate);
+}
+
+/**
+ * Observer accumulating the time spent in card I/O and in the processing as a whole.
+ */
+class PhaseTimingObserver final : public CardTransactionObserver {
+public:
+    PhaseTimingObserver() : mCardIo(0), mProcessing(0) {}
+
+    void
+    onCommandPrepared(const TimePoint timestamp, const std::string& commandName) override {
+        (void)timestamp;
+        (void)commandName;
+    }
+
+    void
+    onProcessingStarted(const TimePoint timestamp) override {
+        mProcessingStart = timestamp;
+    }
+
+    void
+    onProcessingEnded(const TimePoint timestamp) override {
+        mProcessing += timestamp - mProcessingStart;
+    }
+
+    void
+    onApduSent(const TimePoint timestamp, const ByteArrayView apdu) override {
+        (void)apdu;
+        mApduSent = timestamp;
+    }
+
+    void
+    onApduReceived(const TimePoint timestamp, const ByteArrayView apdu) override {
+        (void)apdu;
+        mCardIo += timestamp - mApduSent;
+    }
+
+    void
+    onCryptoStarted(const TimePoint timestamp) override {
+        (void)timestamp;
+    }
+
+    void
+    onCryptoEnded(const TimePoint timestamp) override {
+        (void)timestamp;
+    }
+
+    void
+    onSessionOpened(const TimePoint timestamp) override {
+        (void)timestamp;
+    }
+
+    void
+    onSessionClosed(const TimePoint timestamp, const bool cancelled) override {
+        (void)timestamp;
+        (void)cancelled;
+    }
+
+    /**
+     * Gets the ratio of the processing time spent in card I/O.
+     */
+    double
+    getCardIoRatio() const {
+        if (mProcessing.count() == 0) {
+            return 0.0;
+        }
+
+        return static_cast<double>(mCardIo.count()) / static_cast<double>(mProcessing.count());
+    }
+
+private:
+    TimePoint mProcessingStart;
+    TimePoint mApduSent;
+    std::chrono::steady_clock::duration mCardIo;
+    std::chrono::steady_clock::duration mProcessing;
+};
+
+} /* namespace */
+
+/**
+ * Typical validation: open session with the environment, read contracts and counters, decrease a
+ * counter, append an event, close the session.
+ */
+static void
+BM_SimulatedCard_validationSession(benchmark::State& state) {
+    const auto reader = std::make_shared<SimulatedCardReader>(
+        "SimulatedReader", createSimulatedCard(state.range(0)));
+    const auto card = std::make_shared<ReferenceCalypsoCard>();
+    ReferenceTransactionManager manager(reader, card);
+    const auto observer = std::make_shared<PhaseTimingObserver>();
+    if (state.range(1) != 0) {
+        manager.setTransactionObserver(observer);
+    }
+    const std::vector<uint8_t> event(29, 0xEE);
+    std::vector<double> latencies;
+
+    for (auto _ : state) {
+        const auto start = std::chrono::steady_clock::now();
+        manager.prepareOpenSecureSession(SFI_ENVIRONMENT, 1)
+            .prepareReadRecords(SFI_CONTRACTS, 1, 4, 29)
+            .prepareReadCounter(SFI_COUNTERS, 9)
+            .prepareDecreaseCounter(SFI_COUNTERS, 1, 1)
+            .prepareAppendRecord(SFI_EVENTS_LOG, event)
+            .prepareCloseSecureSession(false)
+            .processCommands(ChannelControl::KEEP_OPEN);
+        latencies.push_back(
+            std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start)
+                .count());
+        manager.reset(reader, card);
+    }
+
+    reportLatencies(state, latencies);
+    if (state.range(1) != 0) {
+        state.counters["card_io_ratio"]
+            = benchmark::Counter(observer->getCardIoRatio(), benchmark::Counter::kAvgThreads);
+    }
+}
+BENCHMARK(BM_SimulatedCard_validationSession)
+    ->ArgNames({"latency_us", "observer"})
+    ->ArgsProduct({{0, 100, 500}, {0, 1}})
+    ->UseRealTime()
+    ->Threads(1)
+    ->Threads(4);
+
+/**
+ * Stored Value debit: SV GET outside the session, then open session, SV DEBIT, close session.
+ */
+static void
+BM_SimulatedCard_svDebitSession(benchmark::State& state) {
+    const auto reader = std::make_shared<SimulatedCardReader>(
+        "SimulatedReader", createSimulatedCard(state.range(0)));
+    const auto card = std::make_shared<ReferenceCalypsoCard>();
+    ReferenceTransactionManager manager(reader, card);
+    std::vector<double> latencies;
+
+    for (auto _ : state) {
+        const auto start = std::chrono::steady_clock::now();
+        manager.prepareSvGet()
+            .prepareOpenSecureSession(SFI_ENVIRONMENT, 1)
+            .prepareSvOperation(-1)
+            .prepareCloseSecureSession(false)
+            .processCommands(ChannelControl::KEEP_OPEN);
+        latencies.push_back(
+            std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start)
+                .count());
+        manager.reset(reader, card);
+    }
+
+    reportLatencies(state, latencies);
+}
+BENCHMARK(BM_SimulatedCard_svDebitSession)->Arg(0)->Arg(100)->Arg(500)->UseRealTime();
+
+/**
+ * Reads the 4 contracts one record at a time: the reads are coalesced into a single APDU.
+ */
+static void
+BM_SimulatedCard_coalescedReads(benchmark::State& state) {
+    const auto reader = std::make_shared<SimulatedCardReader>(
+        "SimulatedReader", createSimulatedCard(state.range(0)));
+    const auto card = std::make_shared<ReferenceCalypsoCard>();
+    ReferenceTransactionManager manager(reader, card);
+    int apduCount = 0;
+
+    for (auto _ : state) {
+        for (int i = 1; i <= 4; i++) {
+            manager.prepareReadRecords(SFI_CONTRACTS, i, i, 29);
+        }
+        apduCount = manager.getPreparedApduCount();
+        manager.processCommands(ChannelControl::KEEP_OPEN);
+        manager.reset(reader, card);
+    }
+
+    state.counters["apdus"] = apduCount;
+}
+BENCHMARK(BM_SimulatedCard_coalescedReads)->Arg(0)->Arg(100)->UseRealTime();
+
+/**
+ * Two modules read overlapping parts of the contracts and of the environment, which is already in
+ * the card image: the partial reads are merged and the environment read is dropped.
+ */
+static void
+BM_SimulatedCard_mergedPartialReads(benchmark::State& state) {
+    const auto reader = std::make_shared<SimulatedCardReader>(
+        "SimulatedReader", createSimulatedCard(state.range(0)));
+    ReferenceTransactionManager manager(reader, std::make_shared<ReferenceCalypsoCard>());
+    manager.enableCachedReadsSkipping();
+    int apduCount = 0;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        manager.reset(reader, std::make_shared<ReferenceCalypsoCard>());
+        manager.prepareReadRecord(SFI_ENVIRONMENT, 1).processCommands(ChannelControl::KEEP_OPEN);
+        state.ResumeTiming();
+
+        manager.prepareReadRecordsPartially(SFI_CONTRACTS, 1, 4, 0, 10)
+            .prepareReadRecord(SFI_ENVIRONMENT, 1)
+            .prepareReadRecordsPartially(SFI_CONTRACTS, 1, 4, 8, 12);
+        apduCount = manager.getPreparedApduCount();
+        manager.processCommands(ChannelControl::KEEP_OPEN);
+    }
+
+    state.counters["apdus"] = apduCount;
+}
+BENCHMARK(BM_SimulatedCard_mergedPartialReads)->Arg(0)->Arg(100)->UseRealTime();
+
+/**
+ * Repeat taps of a card only modified by this terminal: each tap opens a secure session, whose
+ * response reports the transaction counter expected by the card image cache, so the environment
+ * and contracts reads are served from the cache stored at the closing of the previous tap.
+ */
+static void
+BM_SimulatedCard_repeatTapWithCache(benchmark::State& state) {
+    const auto reader = std::make_shared<SimulatedCardReader>(
+        "SimulatedReader", createSimulatedCard(state.range(0)));
+    ReferenceTransactionManager manager(reader, std::make_shared<ReferenceCalypsoCard>());
+    const auto cache = std::make_shared<CardImageCache>(1000);
+    cache->addCacheableFile(FileKey::ofSfi(SFI_ENVIRONMENT));
+    cache->addCacheableFile(FileKey::ofSfi(SFI_CONTRACTS));
+    manager.setCardImageCache(cache);
+    int apduCount = 0;
+
+    for (auto _ : state) {
+        manager.reset(reader, std::make_shared<ReferenceCalypsoCard>());
+        manager.prepareOpenSecureSession(SFI_ENVIRONMENT, 1)
+            .processCommands(ChannelControl::KEEP_OPEN);
+        manager.prepareReadRecord(SFI_ENVIRONMENT, 1).prepareReadRecords(SFI_CONTRACTS, 1, 4, 29);
+        apduCount = manager.getPreparedApduCount();
+        manager.prepareCloseSecureSession(false).processCommands(ChannelControl::KEEP_OPEN);
+    }
+
+    state.counters["apdus"] = apduCount;
+}
+BENCHMARK(BM_SimulatedCard_repeatTapWithCache)->Arg(0)->Arg(100)->UseRealTime();
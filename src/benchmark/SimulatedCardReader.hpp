@@ -0,0 +1,85 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/* Keypop Reader */
+#include "keypop/reader/CardReader.hpp"
+
+/* Benchmark */
+#include "SimulatedCalypsoCard.hpp"
+
+using keypop::reader::CardReader;
+
+class ReferenceTransactionManager;
+
+/**
+ * Card reader stand-in connected to a SimulatedCalypsoCard, for the benchmarks only.
+ *
+ * <p>The Keypop Reader API has no APDU transmission interface: a real implementation transmits
+ * through the card resource services of its reader layer, which this library does not depend on.
+ * The transmission is therefore confined to ReferenceTransactionManager: transmitApdu() is private
+ * and only that class, which recognizes a SimulatedCardReader among the CardReader instances it is
+ * given, can call it. With any other reader the reference manager does no I/O.
+ */
+class SimulatedCardReader final : public CardReader {
+public:
+    SimulatedCardReader(const std::string& name, const std::shared_ptr<SimulatedCalypsoCard> card)
+    : mName(name), mCard(card) {
+    }
+
+    const std::string&
+    getName() const override {
+        return mName;
+    }
+
+    bool
+    isContactless() override {
+        return true;
+    }
+
+    bool
+    isCardPresent() override {
+        return mCard != nullptr;
+    }
+
+    /**
+     * Inserts or removes (null) the simulated card.
+     */
+    void
+    setCard(const std::shared_ptr<SimulatedCalypsoCard> card) {
+        mCard = card;
+    }
+
+private:
+    friend class ReferenceTransactionManager;
+
+    /**
+     * Transmits an APDU to the simulated card and returns its response (status word included).
+     *
+     * @throw std::logic_error If no card is present.
+     */
+    std::vector<uint8_t>
+    transmitApdu(const std::vector<uint8_t>& apdu) {
+        if (!mCard) {
+            throw std::logic_error("No card present");
+        }
+
+        return mCard->processApdu(apdu);
+    }
+
+    const std::string mName;
+    std::shared_ptr<SimulatedCalypsoCard> mCard;
+};
@@ -0,0 +1,257 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+/* Keypop Calypso Card */
+#include "keypop/calypso/card/transaction/AuditLogReader.hpp"
+#include "keypop/calypso/card/transaction/AuditLogWriter.hpp"
+
+/* Benchmark */
+#include "ReferenceCardFactory.hpp"
+#include "ReferenceTransactionManager.hpp"
+
+using keypop::calypso::card::transaction::AuditLogReader;
+using keypop::calypso::card::transaction::AuditLogRecord;
+using keypop::calypso::card::transaction::AuditLogWriter;
+
+namespace {
+
+/**
+ * Audit sink copying the exchanges into a fixed-size ring buffer, overwriting the oldest bytes.
+ */
+class RingBufferAuditSink final : public TransactionAuditSink {
+public:
+    explicit RingBufferAuditSink(const size_t capacity) : mBuffer(capacity), mPosition(0) {}
+
+    void
+    onApduExchange(
+        const Source source, const ByteArrayView command, const ByteArrayView response) override {
+        write(static_cast<uint8_t>(source));
+        write(command);
+        write(response);
+    }
+
+private:
+    void
+    write(const ByteArrayView data) {
+        write(static_cast<uint8_t>(data.size()));
+        for (const uint8_t b : data) {
+            write(b);
+        }
+    }
+
+    void
+    write(const uint8_t b) {
+        mBuffer[mPosition] = b;
+        mPosition = mPosition + 1 == mBuffer.size() ? 0 : mPosition + 1;
+    }
+
+    std::vector<uint8_t> mBuffer;
+    size_t mPosition;
+};
+
+} /* namespace */
+
+static void
+BM_TransactionManager_prepareReadChain(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+    ReferenceTransactionManager manager(nullptr, card);
+
+    for (auto _ : state) {
+        for (uint8_t sfi = 1; sfi <= ReferenceCardFactory::LINEAR_FILES_COUNT; sfi++) {
+            manager.prepareReadRecords(sfi, 1, 4, 29);
+        }
+        manager.prepareReadCounter(ReferenceCardFactory::COUNTER_SFI, 9)
+            .processCommands(ChannelControl::KEEP_OPEN);
+        manager.reset(nullptr, card);
+    }
+}
+BENCHMARK(BM_TransactionManager_prepareReadChain);
+
+static void
+BM_TransactionManager_prepareUpdateRecord_vector(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+    ReferenceTransactionManager manager(nullptr, card);
+
+    for (auto _ : state) {
+        const std::vector<uint8_t> recordData(29, 0x55);
+        manager.prepareUpdateRecord(1, 1, recordData).processCommands(ChannelControl::KEEP_OPEN);
+        manager.reset(nullptr, card);
+    }
+}
+BENCHMARK(BM_TransactionManager_prepareUpdateRecord_vector);
+
+static void
+BM_TransactionManager_prepareUpdateRecord_view(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+    ReferenceTransactionManager manager(nullptr, card);
+
+    for (auto _ : state) {
+        std::array<uint8_t, 29> recordData;
+        recordData.fill(0x55);
+        manager.prepareUpdateRecord(1, 1, recordData).processCommands(ChannelControl::KEEP_OPEN);
+        manager.reset(nullptr, card);
+    }
+}
+BENCHMARK(BM_TransactionManager_prepareUpdateRecord_view);
+
+static void
+BM_TransactionManager_prepareIncreaseCounters_map(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+    ReferenceTransactionManager manager(nullptr, card);
+
+    for (auto _ : state) {
+        const std::map<const int, const int> incValues = {{1, 1}, {2, 2}, {3, 3}, {4, 4}};
+        manager.prepareIncreaseCounters(ReferenceCardFactory::COUNTER_SFI, incValues)
+            .processCommands(ChannelControl::KEEP_OPEN);
+        manager.reset(nullptr, card);
+    }
+}
+BENCHMARK(BM_TransactionManager_prepareIncreaseCounters_map);
+
+static void
+BM_TransactionManager_prepareIncreaseCounters_view(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+    ReferenceTransactionManager manager(nullptr, card);
+
+    for (auto _ : state) {
+        const std::pair<int, int> incValues[] = {{1, 1}, {2, 2}, {3, 3}, {4, 4}};
+        manager.prepareIncreaseCounters(ReferenceCardFactory::COUNTER_SFI, incValues)
+            .processCommands(ChannelControl::KEEP_OPEN);
+        manager.reset(nullptr, card);
+    }
+}
+BENCHMARK(BM_TransactionManager_prepareIncreaseCounters_view);
+
+static void
+BM_TransactionManager_changedDataFullScan(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+    ReferenceTransactionManager manager(nullptr, card);
+    const std::array<uint8_t, 29> recordData = {{0x55}};
+
+    for (auto _ : state) {
+        manager.prepareUpdateRecord(1, 1, recordData)
+            .prepareIncreaseCounter(ReferenceCardFactory::COUNTER_SFI, 1, 1)
+            .processCommands(ChannelControl::KEEP_OPEN);
+        size_t sum = 0;
+        for (const auto& ef : card->getFiles()) {
+            for (const auto& record : ef->getData()->getAllRecordsContent()) {
+                sum += record.second.size();
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_TransactionManager_changedDataFullScan);
+
+static void
+BM_TransactionManager_changedDataJournal(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+    ReferenceTransactionManager manager(nullptr, card);
+    const std::array<uint8_t, 29> recordData = {{0x55}};
+
+    for (auto _ : state) {
+        manager.prepareUpdateRecord(1, 1, recordData)
+            .prepareIncreaseCounter(ReferenceCardFactory::COUNTER_SFI, 1, 1)
+            .processCommands(ChannelControl::KEEP_OPEN);
+        size_t sum = 0;
+        for (const CardChange& change : card->getChanges()) {
+            sum += change.getLength();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_TransactionManager_changedDataJournal);
+
+static void
+BM_TransactionManager_auditDataGrowth(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+    const std::vector<uint8_t> recordData(29, 0x55);
+
+    for (auto _ : state) {
+        ReferenceTransactionManager manager(nullptr, card);
+        for (int64_t i = 0; i < state.range(0); i++) {
+            manager.prepareAppendRecord(1, recordData).processCommands(ChannelControl::KEEP_OPEN);
+        }
+        benchmark::DoNotOptimize(manager.getTransactionAuditData().size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TransactionManager_auditDataGrowth)->Range(8, 512);
+
+static void
+BM_TransactionManager_auditDataCapped(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+    const std::vector<uint8_t> recordData(29, 0x55);
+
+    for (auto _ : state) {
+        ReferenceTransactionManager manager(nullptr, card);
+        manager.setTransactionAuditDataMaxSize(1024);
+        for (int64_t i = 0; i < state.range(0); i++) {
+            manager.prepareAppendRecord(1, recordData).processCommands(ChannelControl::KEEP_OPEN);
+        }
+        benchmark::DoNotOptimize(manager.getTransactionAuditData().size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TransactionManager_auditDataCapped)->Range(8, 512);
+
+static void
+BM_TransactionManager_auditSinkRingBuffer(benchmark::State& state) {
+    const auto card = ReferenceCardFactory::createCard();
+    const std::vector<uint8_t> recordData(29, 0x55);
+    const auto sink = std::make_shared<RingBufferAuditSink>(4096);
+
+    for (auto _ : state) {
+        ReferenceTransactionManager manager(nullptr, card);
+        manager.setTransactionAuditDataMaxSize(0).setTransactionAuditSink(sink);
+        for (int64_t i = 0; i < state.range(0); i++) {
+            manager.prepareAppendRecord(1, recordData).processCommands(ChannelControl::KEEP_OPEN);
+        }
+        benchmark::DoNotOptimize(manager.getTransactionAuditData().size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TransactionManager_auditSinkRingBuffer)->Range(8, 512);
+
+static void
+BM_AuditLog_replay(benchmark::State& state) {
+    AuditLogWriter writer;
+    const std::vector<uint8_t> serial(8, 0x12);
+    const std::vector<uint8_t> command = {0x00, 0xB2, 0x01, 0x3C, 0x00};
+    const std::vector<uint8_t> response(31, 0x90);
+    for (int64_t i = 0; i < state.range(0); i++) {
+        if (i % 8 == 0) {
+            writer.beginTransaction(static_cast<uint64_t>(i), serial);
+        }
+        writer.appendExchange(
+            TransactionAuditSink::Source::CARD, static_cast<uint64_t>(i), command, response);
+    }
+
+    for (auto _ : state) {
+        AuditLogReader reader(writer.getData());
+        AuditLogRecord record;
+        size_t responseBytes = 0;
+        while (reader.next(record)) {
+            responseBytes += record.getResponse().size();
+        }
+        benchmark::DoNotOptimize(responseBytes);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(writer.size()));
+}
+BENCHMARK(BM_AuditLog_replay)->Arg(1 << 20);
@@ -0,0 +1,119 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <array>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Calypso Card */
+#include "keypop/calypso/card/ArrayView.hpp"
+
+using keypop::calypso::card::ArrayView;
+using keypop::calypso::card::ByteArrayView;
+
+namespace {
+
+/* Mirrors the vector/view overload pairs of TransactionManager */
+struct OverloadSet {
+    static int
+    prepareUpdateRecord(const uint8_t, const int, const std::vector<uint8_t>&) {
+        return 1;
+    }
+
+    static int
+    prepareUpdateRecord(const uint8_t, const int, const ByteArrayView) {
+        return 2;
+    }
+
+    static int
+    prepareIncreaseCounters(const uint8_t, const std::map<const int, const int>&) {
+        return 1;
+    }
+
+    static int
+    prepareIncreaseCounters(const uint8_t, const ArrayView<std::pair<int, int>>) {
+        return 2;
+    }
+};
+
+} /* namespace */
+
+TEST(ArrayViewTest, nullPointer_shouldBeEmpty) {
+    const ByteArrayView view(nullptr, 0);
+
+    ASSERT_TRUE(view.empty());
+    ASSERT_EQ(view.size(), 0u);
+    ASSERT_EQ(view.begin(), view.end());
+}
+
+TEST(ArrayViewTest, cArray_shouldViewAllElementsWithoutCopy) {
+    const uint8_t buffer[] = {0x11, 0x22, 0x33};
+    const ByteArrayView view(buffer);
+
+    ASSERT_EQ(view.data(), buffer);
+    ASSERT_EQ(view.size(), 3u);
+    ASSERT_EQ(view[2], 0x33);
+}
+
+TEST(ArrayViewTest, stdArray_shouldViewAllElementsWithoutCopy) {
+    const std::array<uint8_t, 4> buffer = {{0x01, 0x02, 0x03, 0x04}};
+    const ByteArrayView view(buffer);
+
+    ASSERT_EQ(view.data(), buffer.data());
+    ASSERT_EQ(view.size(), 4u);
+}
+
+TEST(ArrayViewTest, vector_shouldViewAllElementsWithoutCopy) {
+    const std::vector<uint8_t> buffer = {0xAA, 0xBB};
+    const ByteArrayView view(buffer);
+
+    ASSERT_EQ(view.data(), buffer.data());
+    ASSERT_EQ(view.toVector(), buffer);
+}
+
+TEST(ArrayViewTest, pointerAndLength_shouldViewSubRange) {
+    const uint8_t buffer[] = {0x00, 0x01, 0x02, 0x03, 0x04};
+    const ByteArrayView view(buffer + 1, 3);
+
+    ASSERT_THAT(view.toVector(), testing::ElementsAre(0x01, 0x02, 0x03));
+}
+
+TEST(ArrayViewTest, nonByteElements_shouldBeIterable) {
+    const std::pair<int, int> values[] = {{1, 10}, {2, 20}};
+    const ArrayView<std::pair<int, int>> view(values);
+
+    int sum = 0;
+    for (const auto& value : view) {
+        sum += value.second;
+    }
+
+    ASSERT_EQ(sum, 30);
+}
+
+TEST(ArrayViewTest, bracedList_shouldSelectVectorOverload) {
+    /* Each of these calls is ill-formed if a braced list can convert to a view */
+    ASSERT_EQ(OverloadSet::prepareUpdateRecord(1, 1, {0x00, 0x05}), 1);
+    ASSERT_EQ(OverloadSet::prepareUpdateRecord(1, 1, {0x00}), 1);
+    ASSERT_EQ(OverloadSet::prepareUpdateRecord(1, 1, {}), 1);
+    ASSERT_EQ(OverloadSet::prepareIncreaseCounters(1, {{1, 10}, {2, 20}}), 1);
+    ASSERT_EQ(OverloadSet::prepareIncreaseCounters(1, {}), 1);
+}
+
+TEST(ArrayViewTest, arrayArgument_shouldSelectViewOverload) {
+    const std::array<uint8_t, 2> data = {{0x00, 0x05}};
+    const std::pair<int, int> values[] = {{1, 10}};
+
+    ASSERT_EQ(OverloadSet::prepareUpdateRecord(1, 1, data), 2);
+    ASSERT_EQ(OverloadSet::prepareUpdateRecord(1, 1, ByteArrayView(data.data(), 1)), 2);
+    ASSERT_EQ(OverloadSet::prepareIncreaseCounters(1, values), 2);
+}
@@ -0,0 +1,110 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <stdexcept>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Calypso Card */
+#include "keypop/calypso/card/transaction/AuditLogReader.hpp"
+#include "keypop/calypso/card/transaction/AuditLogWriter.hpp"
+
+using keypop::calypso::card::ByteArrayView;
+using keypop::calypso::card::transaction::AuditLogReader;
+using keypop::calypso::card::transaction::AuditLogRecord;
+using keypop::calypso::card::transaction::AuditLogWriter;
+using keypop::calypso::card::transaction::spi::TransactionAuditSink;
+
+static const std::vector<uint8_t> SERIAL = {0x00, 0x00, 0x00, 0x00, 0x12, 0x34, 0x56, 0x78};
+static const std::vector<uint8_t> COMMAND = {0x00, 0xB2, 0x01, 0x3C, 0x00};
+static const std::vector<uint8_t> RESPONSE = {0x11, 0x22, 0x90, 0x00};
+
+TEST(AuditLogTest, writer_shouldProduceDocumentedFormat) {
+    AuditLogWriter writer;
+
+    writer.beginTransaction(0x0102, ByteArrayView(SERIAL.data(), 2));
+    writer.appendExchange(TransactionAuditSink::Source::CRYPTO_MODULE, 0x03, COMMAND, RESPONSE);
+
+    const std::vector<uint8_t> expected = {
+        0x01, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x00, 0x00,
+        0x02, 0x00, 0x14, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00,
+        0x05, 0x00, 0xB2, 0x01, 0x3C, 0x00, 0x11, 0x22, 0x90, 0x00};
+    ASSERT_EQ(writer.getData().toVector(), expected);
+}
+
+TEST(AuditLogTest, reader_shouldReadBackWrittenRecords) {
+    AuditLogWriter writer;
+    writer.beginTransaction(1000, SERIAL);
+    writer.appendExchange(TransactionAuditSink::Source::CARD, 1001, COMMAND, RESPONSE);
+    writer.appendExchange(TransactionAuditSink::Source::CRYPTO_MODULE, 1002, RESPONSE, COMMAND);
+
+    AuditLogReader reader(writer.getData());
+    AuditLogRecord record;
+
+    ASSERT_TRUE(reader.next(record));
+    ASSERT_EQ(record.getType(), AuditLogRecord::Type::TRANSACTION);
+    ASSERT_EQ(record.getTimestamp(), 1000u);
+    ASSERT_EQ(record.getCardSerialNumber().toVector(), SERIAL);
+
+    ASSERT_TRUE(reader.next(record));
+    ASSERT_EQ(record.getType(), AuditLogRecord::Type::EXCHANGE);
+    ASSERT_EQ(record.getSource(), TransactionAuditSink::Source::CARD);
+    ASSERT_EQ(record.getTimestamp(), 1001u);
+    ASSERT_EQ(record.getCardSerialNumber().toVector(), SERIAL);
+    ASSERT_EQ(record.getCommand().toVector(), COMMAND);
+    ASSERT_EQ(record.getResponse().toVector(), RESPONSE);
+
+    ASSERT_TRUE(reader.next(record));
+    ASSERT_EQ(record.getSource(), TransactionAuditSink::Source::CRYPTO_MODULE);
+    ASSERT_EQ(record.getCommand().toVector(), RESPONSE);
+    ASSERT_EQ(record.getResponse().toVector(), COMMAND);
+
+    ASSERT_FALSE(reader.next(record));
+}
+
+TEST(AuditLogTest, reader_shouldSkipUnknownRecordTypes) {
+    AuditLogWriter writer;
+    writer.appendExchange(TransactionAuditSink::Source::CARD, 1, COMMAND, RESPONSE);
+    std::vector<uint8_t> data = {0x7F, 0x00, 0x02, 0xAA, 0xBB};
+    const std::vector<uint8_t> exchange = writer.getData().toVector();
+    data.insert(data.end(), exchange.begin(), exchange.end());
+
+    AuditLogReader reader(data);
+    AuditLogRecord record;
+
+    ASSERT_TRUE(reader.next(record));
+    ASSERT_EQ(record.getType(), AuditLogRecord::Type::EXCHANGE);
+    ASSERT_TRUE(record.getCardSerialNumber().empty());
+    ASSERT_FALSE(reader.next(record));
+}
+
+TEST(AuditLogTest, reader_whenRecordIsTruncated_shouldThrowIAE) {
+    AuditLogWriter writer;
+    writer.appendExchange(TransactionAuditSink::Source::CARD, 1, COMMAND, RESPONSE);
+    const ByteArrayView data = writer.getData();
+
+    AuditLogReader reader(ByteArrayView(data.data(), data.size() - 1));
+    AuditLogRecord record;
+
+    EXPECT_THROW(reader.next(record), std::invalid_argument);
+}
+
+TEST(AuditLogTest, clear_shouldKeepCapacityAndRestartLog) {
+    AuditLogWriter writer(16);
+    writer.onApduExchange(TransactionAuditSink::Source::CARD, COMMAND, RESPONSE);
+
+    writer.clear();
+
+    ASSERT_EQ(writer.size(), 0u);
+    AuditLogReader reader(writer.getData());
+    AuditLogRecord record;
+    ASSERT_FALSE(reader.next(record));
+}
@@ -0,0 +1,60 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Calypso Card */
+#include "keypop/calypso/card/card/CardChange.hpp"
+
+using keypop::calypso::card::card::CardChange;
+using keypop::calypso::card::card::FileKey;
+
+TEST(CardChangeTest, ofRecord_shouldDescribeRecordRange) {
+    const CardChange change = CardChange::ofRecord(FileKey::ofSfi(0x07), 3, 4, 10);
+
+    ASSERT_EQ(change.getType(), CardChange::Type::RECORD);
+    ASSERT_EQ(change.getFile(), FileKey::ofSfi(0x07));
+    ASSERT_EQ(change.getNumber(), 3);
+    ASSERT_EQ(change.getOffset(), 4u);
+    ASSERT_EQ(change.getLength(), 10u);
+}
+
+TEST(CardChangeTest, ofBinary_shouldDescribeRangeOfRecord1) {
+    const CardChange change = CardChange::ofBinary(FileKey::ofSfi(0x01), 100, 20);
+
+    ASSERT_EQ(change.getType(), CardChange::Type::BINARY);
+    ASSERT_EQ(change.getNumber(), 1);
+    ASSERT_EQ(change.getOffset(), 100u);
+    ASSERT_EQ(change.getLength(), 20u);
+}
+
+TEST(CardChangeTest, ofCounter_shouldDescribeCounterBytesInRecord1) {
+    const CardChange change = CardChange::ofCounter(FileKey::ofSfi(0x19), 4);
+
+    ASSERT_EQ(change.getType(), CardChange::Type::COUNTER);
+    ASSERT_EQ(change.getNumber(), 4);
+    ASSERT_EQ(change.getOffset(), 9u);
+    ASSERT_EQ(change.getLength(), 3u);
+}
+
+TEST(CardChangeTest, equality_shouldCompareAllFields) {
+    ASSERT_EQ(
+        CardChange::ofRecord(FileKey::ofSfi(0x07), 1, 0, 29),
+        CardChange::ofRecord(FileKey::ofSfi(0x07), 1, 0, 29));
+    ASSERT_NE(
+        CardChange::ofRecord(FileKey::ofSfi(0x07), 1, 0, 29),
+        CardChange::ofRecord(FileKey::ofSfi(0x07), 2, 0, 29));
+    ASSERT_NE(
+        CardChange::ofRecord(FileKey::ofSfi(0x01), 1, 0, 3),
+        CardChange::ofCounter(FileKey::ofSfi(0x01), 1));
+    ASSERT_NE(
+        CardChange::ofRecord(FileKey::ofSfi(0x07), 1, 0, 29),
+        CardChange::ofRecord(FileKey::ofLid(0x07), 1, 0, 29));
+}
@@ -0,0 +1,154 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Calypso Card */
+#include "keypop/calypso/card/transaction/CardImageCache.hpp"
+
+using keypop::calypso::card::card::CardImage;
+using keypop::calypso::card::card::FileKey;
+using keypop::calypso::card::transaction::CardImageCache;
+using testing::ElementsAre;
+
+namespace {
+
+const std::vector<uint8_t> SERIAL_1 = {0x00, 0x00, 0x00, 0x00, 0x11, 0x22, 0x33, 0x44};
+const std::vector<uint8_t> SERIAL_2 = {0x00, 0x00, 0x00, 0x00, 0x55, 0x66, 0x77, 0x88};
+const std::vector<uint8_t> SERIAL_3 = {0x00, 0x00, 0x00, 0x00, 0x99, 0xAA, 0xBB, 0xCC};
+const FileKey SFI_07 = FileKey::ofSfi(0x07);
+
+CardImage
+createImage(const uint8_t value) {
+    CardImage image;
+    image.setContent(SFI_07, 1, std::vector<uint8_t>{value});
+    return image;
+}
+
+} /* namespace */
+
+TEST(CardImageCacheTest, constructor_whenMaxEntriesIsZero_shouldThrowInvalidArgument) {
+    ASSERT_THROW(CardImageCache(0), std::invalid_argument);
+}
+
+TEST(CardImageCacheTest, find_whenSameTransactionCounter_shouldReturnCachedImage) {
+    CardImageCache cache(2);
+    cache.put(SERIAL_1, 100, createImage(0x01));
+
+    const CardImage* image = cache.find(SERIAL_1, 100);
+
+    ASSERT_NE(image, nullptr);
+    ASSERT_THAT(image->getContent(SFI_07, 1).toVector(), ElementsAre(0x01));
+}
+
+TEST(CardImageCacheTest, find_whenTransactionCounterChanged_shouldReturnNull) {
+    CardImageCache cache(2);
+    cache.put(SERIAL_1, 100, createImage(0x01));
+
+    ASSERT_EQ(cache.find(SERIAL_1, 99), nullptr);
+    ASSERT_EQ(cache.find(SERIAL_2, 100), nullptr);
+}
+
+TEST(CardImageCacheTest, put_whenSameCard_shouldReplaceEntry) {
+    CardImageCache cache(2);
+    cache.put(SERIAL_1, 100, createImage(0x01));
+
+    cache.put(SERIAL_1, 99, createImage(0x02));
+
+    ASSERT_EQ(cache.size(), 1u);
+    ASSERT_EQ(cache.find(SERIAL_1, 100), nullptr);
+    ASSERT_THAT(cache.find(SERIAL_1, 99)->getContent(SFI_07, 1).toVector(), ElementsAre(0x02));
+}
+
+TEST(CardImageCacheTest, put_whenFull_shouldEvictLeastRecentlyUsedEntry) {
+    CardImageCache cache(2);
+    cache.put(SERIAL_1, 100, createImage(0x01));
+    cache.put(SERIAL_2, 200, createImage(0x02));
+    cache.find(SERIAL_1, 100);
+
+    cache.put(SERIAL_3, 300, createImage(0x03));
+
+    ASSERT_EQ(cache.size(), 2u);
+    ASSERT_NE(cache.find(SERIAL_1, 100), nullptr);
+    ASSERT_EQ(cache.find(SERIAL_2, 200), nullptr);
+    ASSERT_THAT(cache.find(SERIAL_3, 300)->getContent(SFI_07, 1).toVector(), ElementsAre(0x03));
+}
+
+TEST(CardImageCacheTest, put_whenSameCardStoredAgain_shouldMarkItRecentlyUsed) {
+    CardImageCache cache(2);
+    cache.put(SERIAL_1, 100, createImage(0x01));
+    cache.put(SERIAL_2, 200, createImage(0x02));
+    cache.put(SERIAL_1, 99, createImage(0x04));
+
+    cache.put(SERIAL_3, 300, createImage(0x03));
+
+    ASSERT_THAT(cache.find(SERIAL_1, 99)->getContent(SFI_07, 1).toVector(), ElementsAre(0x04));
+    ASSERT_EQ(cache.find(SERIAL_2, 200), nullptr);
+}
+
+TEST(CardImageCacheTest, put_afterRemove_shouldEvictInUseOrder) {
+    CardImageCache cache(2);
+    cache.put(SERIAL_1, 100, createImage(0x01));
+    cache.put(SERIAL_2, 200, createImage(0x02));
+    cache.remove(SERIAL_1);
+    cache.put(SERIAL_3, 300, createImage(0x03));
+
+    cache.put(SERIAL_1, 101, createImage(0x05));
+
+    ASSERT_EQ(cache.size(), 2u);
+    ASSERT_EQ(cache.find(SERIAL_2, 200), nullptr);
+    ASSERT_NE(cache.find(SERIAL_3, 300), nullptr);
+    ASSERT_NE(cache.find(SERIAL_1, 101), nullptr);
+}
+
+TEST(CardImageCacheTest, serialNumbers_withDifferentLengths_shouldBeDistinct) {
+    CardImageCache cache(2);
+    cache.put(std::vector<uint8_t>{0x11, 0x22}, 100, createImage(0x01));
+
+    ASSERT_EQ(cache.find(std::vector<uint8_t>{0x00, 0x11, 0x22}, 100), nullptr);
+    ASSERT_THROW(cache.find(std::vector<uint8_t>(9), 100), std::invalid_argument);
+}
+
+TEST(CardImageCacheTest, remove_shouldDiscardEntry) {
+    CardImageCache cache(2);
+    cache.put(SERIAL_1, 100, createImage(0x01));
+
+    cache.remove(SERIAL_1);
+
+    ASSERT_EQ(cache.size(), 0u);
+    ASSERT_EQ(cache.find(SERIAL_1, 100), nullptr);
+}
+
+TEST(CardImageCacheTest, isCacheable_shouldOnlyAcceptDeclaredFiles) {
+    CardImageCache cache(2);
+    cache.addCacheableFile(FileKey::ofSfi(0x09));
+    cache.addCacheableFile(SFI_07);
+    cache.addCacheableFile(SFI_07);
+
+    ASSERT_TRUE(cache.isCacheable(SFI_07));
+    ASSERT_TRUE(cache.isCacheable(FileKey::ofSfi(0x09)));
+    ASSERT_FALSE(cache.isCacheable(FileKey::ofSfi(0x08)));
+    ASSERT_FALSE(cache.isCacheable(FileKey::ofLid(0x07)));
+}
+
+TEST(CardImageCacheTest, clear_shouldKeepCacheableFiles) {
+    CardImageCache cache(2);
+    cache.addCacheableFile(SFI_07);
+    cache.put(SERIAL_1, 100, createImage(0x01));
+
+    cache.clear();
+
+    ASSERT_EQ(cache.size(), 0u);
+    ASSERT_TRUE(cache.isCacheable(SFI_07));
+}
@@ -0,0 +1,371 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Calypso Card */
+#include "keypop/calypso/card/card/CardImage.hpp"
+
+using keypop::calypso::card::card::CardImage;
+using keypop::calypso::card::card::FileKey;
+using testing::ElementsAre;
+
+namespace {
+
+const FileKey SFI_06 = FileKey::ofSfi(0x06);
+const FileKey SFI_07 = FileKey::ofSfi(0x07);
+const FileKey SFI_08 = FileKey::ofSfi(0x08);
+const FileKey SFI_09 = FileKey::ofSfi(0x09);
+const FileKey SFI_19 = FileKey::ofSfi(0x19);
+
+} /* namespace */
+
+TEST(CardImageTest, getContent_whenRecordNotSet_shouldReturnEmptyView) {
+    CardImage image;
+    image.setContent(SFI_07, 1, std::vector<uint8_t>{0x11});
+
+    ASSERT_TRUE(image.getContent(SFI_07, 2).empty());
+    ASSERT_TRUE(image.getContent(SFI_08, 1).empty());
+}
+
+TEST(CardImageTest, setContent_shouldStoreRecordsContiguouslyAndSortIndex) {
+    CardImage image;
+    image.setContent(SFI_08, 1, std::vector<uint8_t>{0x81});
+    image.setContent(SFI_07, 2, std::vector<uint8_t>{0x72, 0x72});
+    image.setContent(SFI_07, 1, std::vector<uint8_t>{0x71});
+
+    ASSERT_EQ(image.getArena().size(), 4u);
+    ASSERT_EQ(image.getRecords().size(), 3u);
+    ASSERT_EQ(image.getRecords()[0].file, SFI_07);
+    ASSERT_EQ(image.getRecords()[0].number, 1);
+    ASSERT_EQ(image.getRecords()[2].file, SFI_08);
+    ASSERT_THAT(image.getContent(SFI_07, 2).toVector(), ElementsAre(0x72, 0x72));
+}
+
+TEST(CardImageTest, getRecords_withFileKey_shouldReturnRecordsOfFileOnly) {
+    CardImage image;
+    image.setContent(SFI_06, 1, std::vector<uint8_t>{0x61});
+    image.setContent(SFI_07, 1, std::vector<uint8_t>{0x71});
+    image.setContent(SFI_07, 3, std::vector<uint8_t>{0x73});
+    image.setContent(SFI_08, 1, std::vector<uint8_t>{0x81});
+
+    const auto records = image.getRecords(SFI_07);
+
+    ASSERT_EQ(records.size(), 2u);
+    ASSERT_EQ(records[0].number, 1);
+    ASSERT_EQ(records[1].number, 3);
+    ASSERT_TRUE(image.getRecords(SFI_09).empty());
+}
+
+TEST(CardImageTest, setContent_withOffset_shouldKeepOtherBytesAndPadGap) {
+    CardImage image;
+    image.setContent(SFI_07, 1, std::vector<uint8_t>{0x01, 0x02, 0x03});
+
+    image.setContent(SFI_07, 1, std::vector<uint8_t>{0xA2}, 1);
+    ASSERT_THAT(image.getContent(SFI_07, 1).toVector(), ElementsAre(0x01, 0xA2, 0x03));
+
+    image.setContent(SFI_07, 1, std::vector<uint8_t>{0xA5}, 4);
+    ASSERT_THAT(image.getContent(SFI_07, 1).toVector(), ElementsAre(0x01, 0xA2, 0x03, 0x00, 0xA5));
+}
+
+TEST(CardImageTest, setContent_whenRecordShrinks_shouldReuseItsArea) {
+    CardImage image;
+    image.setContent(SFI_07, 1, std::vector<uint8_t>{0x01, 0x02, 0x03});
+
+    image.setContent(SFI_07, 1, std::vector<uint8_t>{0x04});
+
+    ASSERT_EQ(image.getArena().size(), 3u);
+    ASSERT_THAT(image.getContent(SFI_07, 1).toVector(), ElementsAre(0x04));
+}
+
+TEST(CardImageTest, compact_shouldReleaseAreasOfMovedRecords) {
+    CardImage image;
+    image.setContent(SFI_07, 1, std::vector<uint8_t>{0x01});
+    image.setContent(SFI_07, 2, std::vector<uint8_t>{0x02});
+    image.setContent(SFI_07, 1, std::vector<uint8_t>{0x11, 0x12});
+    ASSERT_EQ(image.getArena().size(), 4u);
+
+    image.compact();
+
+    ASSERT_THAT(image.getArena().toVector(), ElementsAre(0x11, 0x12, 0x02));
+    ASSERT_THAT(image.getContent(SFI_07, 2).toVector(), ElementsAre(0x02));
+}
+
+TEST(CardImageTest, copy_shouldBeIndependent) {
+    CardImage image;
+    image.setContent(SFI_07, 1, std::vector<uint8_t>{0x01});
+
+    CardImage copy = image;
+    copy.setContent(SFI_07, 1, std::vector<uint8_t>{0x02});
+
+    ASSERT_THAT(image.getContent(SFI_07, 1).toVector(), ElementsAre(0x01));
+    ASSERT_THAT(copy.getContent(SFI_07, 1).toVector(), ElementsAre(0x02));
+}
+
+TEST(CardImageTest, setContent_whenTooLong_shouldThrowInvalidArgument) {
+    CardImage image;
+
+    ASSERT_THROW(
+        image.setContent(SFI_07, 1, std::vector<uint8_t>{0x01}, CardImage::MAX_RECORD_LENGTH),
+        std::invalid_argument);
+}
+
+TEST(CardImageTest, serialize_shouldWriteHeaderIndexGapsAndCompactedArena) {
+    CardImage image;
+    image.setContent(SFI_07, 1, std::vector<uint8_t>{0x01});
+    image.setContent(SFI_07, 2, std::vector<uint8_t>{0x02});
+    image.setContent(SFI_07, 1, std::vector<uint8_t>{0x11, 0x12});
+    image.setContent(SFI_08, 1, std::vector<uint8_t>{0x81}, 2);
+    std::vector<uint8_t> out = {0xFF};
+
+    image.serialize(out);
+
+    ASSERT_THAT(
+        out,
+        ElementsAre(
+            0xFF,
+            /* Header */
+            0x01, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x06,
+            /* Index */
+            0x00, 0x00, 0x07, 0x01, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x07, 0x02, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x02,
+            0x00, 0x00, 0x08, 0x01, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x03,
+            /* Unknown ranges */
+            0x00, 0x00, 0x08, 0x01, 0x00, 0x00, 0x00, 0x02,
+            /* Arena */
+            0x11, 0x12, 0x02, 0x00, 0x00, 0x81));
+}
+
+TEST(CardImageTest, deserialize_shouldRestoreSerializedImage) {
+    CardImage image;
+    image.setContent(FileKey::svLoadLog(), 1, std::vector<uint8_t>(22));
+    image.setContent(FileKey::ofLid(0x2010), 1, std::vector<uint8_t>{0x20});
+    image.setContent(SFI_07, 1, std::vector<uint8_t>{0x71, 0x72});
+    image.setContent(SFI_19, 1, std::vector<uint8_t>{0x00, 0x00, 0x64});
+    image.setContent(SFI_19, 1, std::vector<uint8_t>{0x00, 0x00, 0xC8}, 6);
+    std::vector<uint8_t> serialized;
+    image.serialize(serialized);
+    serialized.push_back(0xEE);
+
+    CardImage restored;
+    const size_t size = restored.deserialize(serialized);
+
+    ASSERT_EQ(size, serialized.size() - 1);
+    ASSERT_EQ(restored.getRecords().size(), 4u);
+    ASSERT_EQ(restored.getContent(FileKey::svLoadLog(), 1).size(), 22u);
+    ASSERT_THAT(restored.getContent(FileKey::ofLid(0x2010), 1).toVector(), ElementsAre(0x20));
+    ASSERT_THAT(restored.getContent(SFI_07, 1).toVector(), ElementsAre(0x71, 0x72));
+    ASSERT_THAT(
+        restored.getContent(SFI_19, 1).toVector(),
+        ElementsAre(0x00, 0x00, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC8));
+    ASSERT_TRUE(restored.isComplete(SFI_07, 1));
+    ASSERT_FALSE(restored.isComplete(SFI_19, 1));
+    ASSERT_TRUE(restored.isKnown(SFI_19, 1, 0, 3));
+    ASSERT_FALSE(restored.isKnown(SFI_19, 1, 3, 1));
+    ASSERT_TRUE(restored.isKnown(SFI_19, 1, 6, 3));
+}
+
+TEST(CardImageTest, deserialize_whenTruncated_shouldThrowAndLeaveImageEmpty) {
+    CardImage image;
+    image.setContent(SFI_07, 1, std::vector<uint8_t>{0x71, 0x72});
+    std::vector<uint8_t> serialized;
+    image.serialize(serialized);
+    serialized.pop_back();
+
+    ASSERT_THROW(image.deserialize(serialized), std::invalid_argument);
+    ASSERT_TRUE(image.getRecords().empty());
+}
+
+TEST(CardImageTest, deserialize_whenMalformed_shouldThrowInvalidArgument) {
+    CardImage image;
+    const std::vector<uint8_t> badVersion = {
+        0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    const std::vector<uint8_t> badOffset = {
+        0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+        0x00, 0x00, 0x07, 0x01, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01,
+        0xAA};
+    const std::vector<uint8_t> badSpace = {
+        0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x03, 0x00, 0x07, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    const std::vector<uint8_t> badFlags = {
+        0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x07, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    const std::vector<uint8_t> unsorted = {
+        0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x07, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x07, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    const std::vector<uint8_t> gapBeyondContent = {
+        0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01,
+        0x00, 0x00, 0x07, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x07, 0x01, 0x00, 0x00, 0x00, 0x02,
+        0xAA};
+    const std::vector<uint8_t> hugeCount = {
+        0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+    ASSERT_THROW(image.deserialize(badVersion), std::invalid_argument);
+    ASSERT_THROW(image.deserialize(badOffset), std::invalid_argument);
+    ASSERT_THROW(image.deserialize(badSpace), std::invalid_argument);
+    ASSERT_THROW(image.deserialize(badFlags), std::invalid_argument);
+    ASSERT_THROW(image.deserialize(unsorted), std::invalid_argument);
+    ASSERT_THROW(image.deserialize(gapBeyondContent), std::invalid_argument);
+    ASSERT_THROW(image.deserialize(hugeCount), std::invalid_argument);
+}
+
+TEST(CardImageTest, deserialize_whenRecordsOverlap_shouldThrowInvalidArgument) {
+    CardImage image;
+    /* Records 1 and 2 of SFI 07, 2 bytes each, at offsets 1 and 0 of a 3-byte arena */
+    const std::vector<uint8_t> overlapping = {
+        0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03,
+        0x00, 0x00, 0x07, 0x01, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01,
+        0x00, 0x00, 0x07, 0x02, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00,
+        0xAA, 0xBB, 0xCC};
+    /* Same records at offsets 2 and 0 of a 4-byte arena */
+    const std::vector<uint8_t> adjacent = {
+        0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04,
+        0x00, 0x00, 0x07, 0x01, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02,
+        0x00, 0x00, 0x07, 0x02, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00,
+        0xAA, 0xBB, 0xCC, 0xDD};
+
+    ASSERT_THROW(image.deserialize(overlapping), std::invalid_argument);
+    ASSERT_TRUE(image.getRecords().empty());
+
+    ASSERT_EQ(image.deserialize(adjacent), adjacent.size());
+    ASSERT_THAT(image.getContent(SFI_07, 1).toVector(), ElementsAre(0xCC, 0xDD));
+    ASSERT_THAT(image.getContent(SFI_07, 2).toVector(), ElementsAre(0xAA, 0xBB));
+}
+
+TEST(CardImageTest, setContent_withKeysOfDifferentSpaces_shouldKeepFilesDistinct) {
+    CardImage image;
+    image.setContent(SFI_07, 1, std::vector<uint8_t>{0x01});
+    image.setContent(FileKey::ofLid(0x07), 1, std::vector<uint8_t>{0x02});
+    image.setContent(FileKey::svLoadLog(), 1, std::vector<uint8_t>{0x03});
+    image.setContent(FileKey::svDebitLog(), 1, std::vector<uint8_t>{0x04});
+
+    ASSERT_EQ(image.getRecords().size(), 4u);
+    ASSERT_THAT(image.getContent(SFI_07, 1).toVector(), ElementsAre(0x01));
+    ASSERT_THAT(image.getContent(FileKey::ofLid(0x07), 1).toVector(), ElementsAre(0x02));
+    ASSERT_THAT(image.getContent(FileKey::svLoadLog(), 1).toVector(), ElementsAre(0x03));
+    ASSERT_THAT(image.getContent(FileKey::svDebitLog(), 1).toVector(), ElementsAre(0x04));
+}
+
+TEST(CardImageTest, removeContent_shouldRemoveRecordOnly) {
+    CardImage image;
+    image.setContent(SFI_07, 1, std::vector<uint8_t>{0x01});
+    image.setContent(SFI_07, 2, std::vector<uint8_t>{0x02});
+
+    image.removeContent(SFI_07, 2);
+    image.removeContent(SFI_08, 1);
+
+    ASSERT_EQ(image.getRecords().size(), 1u);
+    ASSERT_TRUE(image.getContent(SFI_07, 2).empty());
+    ASSERT_THAT(image.getContent(SFI_07, 1).toVector(), ElementsAre(0x01));
+}
+
+TEST(CardImageTest, serialize_whenMoreThan65535Records_shouldRestoreAllRecords) {
+    CardImage image;
+    for (uint16_t lid = 1; lid <= 300; lid++) {
+        for (int numRecord = 1; numRecord <= 255; numRecord++) {
+            image.setContent(
+                FileKey::ofLid(lid), static_cast<uint8_t>(numRecord), std::vector<uint8_t>());
+        }
+    }
+    std::vector<uint8_t> serialized;
+    image.serialize(serialized);
+
+    CardImage restored;
+    restored.deserialize(serialized);
+
+    ASSERT_EQ(restored.getRecords().size(), 300u * 255u);
+    ASSERT_EQ(restored.getRecords(FileKey::ofLid(300)).size(), 255u);
+}
+
+TEST(CardImageTest, setContent_withOffsetBeyondLength_shouldRecordPaddingAsUnknown) {
+    CardImage image;
+    image.setContent(SFI_07, 1, std::vector<uint8_t>(10, 0xAA), 10);
+
+    ASSERT_EQ(image.getContent(SFI_07, 1).size(), 20u);
+    ASSERT_FALSE(image.isComplete(SFI_07, 1));
+    ASSERT_TRUE(image.isKnown(SFI_07, 1, 10, 10));
+    ASSERT_FALSE(image.isKnown(SFI_07, 1, 0, 10));
+    ASSERT_FALSE(image.isKnown(SFI_07, 1, 5, 10));
+    ASSERT_FALSE(image.isKnown(SFI_07, 1, 10, 11));
+
+    image.setContent(SFI_07, 1, std::vector<uint8_t>(5, 0xBB), 0);
+
+    ASSERT_TRUE(image.isKnown(SFI_07, 1, 0, 5));
+    ASSERT_FALSE(image.isKnown(SFI_07, 1, 0, 10));
+    ASSERT_EQ(image.getGaps().size(), 1u);
+    ASSERT_EQ(image.getGaps()[0].offset, 5);
+    ASSERT_EQ(image.getGaps()[0].length, 5);
+
+    image.setContent(SFI_07, 1, std::vector<uint8_t>(5, 0xCC), 5);
+
+    ASSERT_TRUE(image.isKnown(SFI_07, 1, 0, 20));
+    ASSERT_TRUE(image.getGaps().empty());
+    ASSERT_FALSE(image.isComplete(SFI_07, 1));
+}
+
+TEST(CardImageTest, setContent_withWholeContent_shouldMakeRecordComplete) {
+    CardImage image;
+    image.setContent(SFI_07, 1, std::vector<uint8_t>{0x01}, 3);
+    ASSERT_FALSE(image.isComplete(SFI_07, 1));
+
+    image.setContent(SFI_07, 1, std::vector<uint8_t>{0x01, 0x02});
+
+    ASSERT_TRUE(image.isComplete(SFI_07, 1));
+    ASSERT_TRUE(image.getGaps().empty());
+    ASSERT_FALSE(image.isComplete(SFI_07, 2));
+
+    image.setContent(SFI_07, 1, std::vector<uint8_t>{0x03}, 1);
+    ASSERT_TRUE(image.isComplete(SFI_07, 1));
+
+    image.setContent(SFI_07, 1, std::vector<uint8_t>{0x04}, 2);
+    ASSERT_FALSE(image.isComplete(SFI_07, 1));
+}
+
+TEST(CardImageTest, fillContent_shouldKeepUnknownBytesUnknown) {
+    CardImage image;
+    image.setContent(SFI_07, 1, std::vector<uint8_t>{0x01, 0x02});
+
+    image.fillContent(SFI_07, 1, std::vector<uint8_t>{0x10}, 1);
+
+    ASSERT_THAT(image.getContent(SFI_07, 1).toVector(), ElementsAre(0x01, 0x12));
+    ASSERT_TRUE(image.isComplete(SFI_07, 1));
+
+    image.fillContent(SFI_07, 1, std::vector<uint8_t>{0xF0}, 3);
+
+    ASSERT_THAT(image.getContent(SFI_07, 1).toVector(), ElementsAre(0x01, 0x12, 0x00, 0xF0));
+    ASSERT_FALSE(image.isComplete(SFI_07, 1));
+    ASSERT_TRUE(image.isKnown(SFI_07, 1, 0, 2));
+    ASSERT_FALSE(image.isKnown(SFI_07, 1, 3, 1));
+}
+
+TEST(CardImageTest, addCyclicContent_shouldShiftRecordsWithTheirUnknownRanges) {
+    CardImage image;
+    image.setContent(SFI_07, 1, std::vector<uint8_t>{0x01});
+    image.setContent(SFI_07, 2, std::vector<uint8_t>{0x02}, 1);
+    image.setContent(SFI_07, 3, std::vector<uint8_t>{0x03});
+    image.setContent(SFI_08, 1, std::vector<uint8_t>{0x81});
+
+    image.addCyclicContent(SFI_07, std::vector<uint8_t>{0x04});
+
+    ASSERT_EQ(image.getRecords(SFI_07).size(), 3u);
+    ASSERT_THAT(image.getContent(SFI_07, 1).toVector(), ElementsAre(0x04));
+    ASSERT_THAT(image.getContent(SFI_07, 2).toVector(), ElementsAre(0x01));
+    ASSERT_THAT(image.getContent(SFI_07, 3).toVector(), ElementsAre(0x00, 0x02));
+    ASSERT_TRUE(image.isComplete(SFI_07, 2));
+    ASSERT_FALSE(image.isKnown(SFI_07, 3, 0, 1));
+    ASSERT_TRUE(image.isKnown(SFI_07, 3, 1, 1));
+    ASSERT_THAT(image.getContent(SFI_08, 1).toVector(), ElementsAre(0x81));
+}
@@ -0,0 +1,148 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Calypso Card */
+#include "keypop/calypso/card/card/CardSnapshot.hpp"
+
+using keypop::calypso::card::ByteArrayView;
+using keypop::calypso::card::card::CardSnapshot;
+using keypop::calypso::card::card::ElementaryFile;
+using keypop::calypso::card::card::FileKey;
+
+namespace {
+
+CardSnapshot
+createSnapshot() {
+    CardSnapshot snapshot;
+    snapshot.powerOnData = "3B8F8001";
+    snapshot.selectApplicationResponse = {0x6F, 0x23, 0x90, 0x00};
+    snapshot.productType = 3;
+    snapshot.dfName = {0x31, 0x54, 0x49, 0x43};
+    snapshot.applicationSerialNumber = {0x00, 0x00, 0x00, 0x00, 0x12, 0x34, 0x56, 0x78};
+    snapshot.startupInfo = {0x0A, 0x3C, 0x20, 0x05, 0x14, 0x10, 0x01};
+    snapshot.traceabilityInformation = {0xAA, 0xBB};
+    snapshot.flags = CardSnapshot::FLAG_HCE | CardSnapshot::FLAG_SV_FEATURE;
+
+    snapshot.hasDfHeader = true;
+    snapshot.dfHeader.lid = 0x2000;
+    snapshot.dfHeader.dfStatus = 0x01;
+    snapshot.dfHeader.accessConditions = {0x10, 0x11, 0x12, 0x13};
+    snapshot.dfHeader.keyIndexes = {0x01, 0x02, 0x03, 0x04};
+    snapshot.dfHeader.kifs = {{0x21, 0x27, 0x30}};
+    snapshot.dfHeader.kvcs = {{0x79, 0x7A, 0x7B}};
+
+    CardSnapshot::EfHeader header;
+    header.sfi = 0x07;
+    header.lid = 0x2010;
+    header.efType = ElementaryFile::Type::CYCLIC;
+    header.recordsNumber = 3;
+    header.recordSize = 29;
+    header.accessConditions = {0x1F, 0x00, 0x00, 0x00};
+    header.keyIndexes = {0x01, 0x01, 0x00, 0x00};
+    header.presence = CardSnapshot::HEADER_SHARED_REFERENCE;
+    header.dfStatus = 0;
+    header.sharedReference = 0x3F07;
+    snapshot.efHeaders.push_back(header);
+
+    snapshot.sessionData =
+        CardSnapshot::SESSION_TRANSACTION_COUNTER | CardSnapshot::SESSION_SV_DATA;
+    snapshot.transactionCounter = 0x123456;
+    snapshot.svBalance = -100;
+    snapshot.svLastTNum = 0x0102;
+
+    snapshot.cardImage.setContent(FileKey::ofSfi(0x07), 1, std::vector<uint8_t>{0x01, 0x02});
+    return snapshot;
+}
+
+} /* namespace */
+
+TEST(CardSnapshotTest, deserialize_shouldRestoreEveryField) {
+    std::vector<uint8_t> serialized;
+    createSnapshot().serialize(serialized);
+
+    CardSnapshot restored;
+    ASSERT_EQ(restored.deserialize(ByteArrayView(serialized)), serialized.size());
+
+    const CardSnapshot expected = createSnapshot();
+    ASSERT_EQ(restored.powerOnData, expected.powerOnData);
+    ASSERT_EQ(restored.selectApplicationResponse, expected.selectApplicationResponse);
+    ASSERT_EQ(restored.productType, expected.productType);
+    ASSERT_EQ(restored.dfName, expected.dfName);
+    ASSERT_EQ(restored.applicationSerialNumber, expected.applicationSerialNumber);
+    ASSERT_EQ(restored.startupInfo, expected.startupInfo);
+    ASSERT_EQ(restored.traceabilityInformation, expected.traceabilityInformation);
+    ASSERT_EQ(restored.flags, expected.flags);
+
+    ASSERT_TRUE(restored.hasDfHeader);
+    ASSERT_EQ(restored.dfHeader.lid, expected.dfHeader.lid);
+    ASSERT_EQ(restored.dfHeader.dfStatus, expected.dfHeader.dfStatus);
+    ASSERT_EQ(restored.dfHeader.accessConditions, expected.dfHeader.accessConditions);
+    ASSERT_EQ(restored.dfHeader.keyIndexes, expected.dfHeader.keyIndexes);
+    ASSERT_EQ(restored.dfHeader.kifs, expected.dfHeader.kifs);
+    ASSERT_EQ(restored.dfHeader.kvcs, expected.dfHeader.kvcs);
+
+    ASSERT_EQ(restored.efHeaders.size(), 1u);
+    const CardSnapshot::EfHeader& header = restored.efHeaders[0];
+    ASSERT_EQ(header.sfi, 0x07);
+    ASSERT_EQ(header.lid, 0x2010);
+    ASSERT_EQ(header.efType, ElementaryFile::Type::CYCLIC);
+    ASSERT_EQ(header.recordsNumber, 3);
+    ASSERT_EQ(header.recordSize, 29);
+    ASSERT_EQ(header.accessConditions, expected.efHeaders[0].accessConditions);
+    ASSERT_EQ(header.keyIndexes, expected.efHeaders[0].keyIndexes);
+    ASSERT_EQ(header.presence, static_cast<uint8_t>(CardSnapshot::HEADER_SHARED_REFERENCE));
+    ASSERT_EQ(header.sharedReference, 0x3F07);
+
+    ASSERT_EQ(restored.sessionData, expected.sessionData);
+    ASSERT_EQ(restored.transactionCounter, 0x123456);
+    ASSERT_EQ(restored.pinAttemptRemaining, 0);
+    ASSERT_EQ(restored.svBalance, -100);
+    ASSERT_EQ(restored.svLastTNum, 0x0102);
+    ASSERT_EQ(
+        restored.cardImage.getContent(FileKey::ofSfi(0x07), 1).toVector(),
+        std::vector<uint8_t>({0x01, 0x02}));
+}
+
+TEST(CardSnapshotTest, deserialize_whenTruncated_shouldThrowInvalidArgument) {
+    std::vector<uint8_t> serialized;
+    createSnapshot().serialize(serialized);
+
+    for (size_t size = 0; size < serialized.size(); size++) {
+        CardSnapshot restored;
+        ASSERT_THROW(
+            restored.deserialize(ByteArrayView(serialized.data(), size)), std::invalid_argument);
+    }
+}
+
+TEST(CardSnapshotTest, deserialize_whenUnsupportedVersion_shouldThrowInvalidArgument) {
+    std::vector<uint8_t> serialized;
+    createSnapshot().serialize(serialized);
+    serialized[0] = CardSnapshot::FORMAT_VERSION + 1;
+
+    CardSnapshot restored;
+    ASSERT_THROW(restored.deserialize(ByteArrayView(serialized)), std::invalid_argument);
+}
+
+TEST(CardSnapshotTest, deserialize_whenEfTypeIsUnknown_shouldThrowInvalidArgument) {
+    CardSnapshot snapshot = createSnapshot();
+    snapshot.hasDfHeader = false;
+    snapshot.efHeaders[0].efType = static_cast<ElementaryFile::Type>(0x7F);
+    std::vector<uint8_t> serialized;
+    snapshot.serialize(serialized);
+
+    CardSnapshot restored;
+    ASSERT_THROW(restored.deserialize(ByteArrayView(serialized)), std::invalid_argument);
+}
@@ -0,0 +1,82 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <stdexcept>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Calypso Card */
+#include "keypop/calypso/card/card/CounterValues.hpp"
+
+using keypop::calypso::card::card::CounterValues;
+
+TEST(CounterValuesTest, decode_shouldDecodeBigEndian3ByteValues) {
+    const uint8_t data[] = {0x00, 0x00, 0x01, 0x12, 0x34, 0x56, 0xFF, 0xFF, 0xFF};
+    int32_t values[3];
+
+    CounterValues::decode(data, 3, values);
+
+    ASSERT_EQ(values[0], 1);
+    ASSERT_EQ(values[1], 0x123456);
+    ASSERT_EQ(values[2], 0xFFFFFF);
+}
+
+TEST(CounterValuesTest, defaultConstructor_shouldHaveNoCounter) {
+    const CounterValues counters;
+
+    ASSERT_EQ(counters.getCount(), 0u);
+    ASSERT_FALSE(counters.getValue(1).isPresent());
+}
+
+TEST(CounterValuesTest, setFromRecord_shouldIgnoreTruncatedLastCounter) {
+    const uint8_t record[] = {0x00, 0x00, 0x0A, 0x00, 0x01, 0x00, 0x07, 0x08};
+    CounterValues counters;
+
+    counters.setFromRecord(record, sizeof(record));
+
+    ASSERT_EQ(counters.getCount(), 2u);
+    ASSERT_EQ(counters.getValue(1).get(), 10);
+    ASSERT_EQ(counters.getValue(2).get(), 256);
+    ASSERT_FALSE(counters.getValue(3).isPresent());
+    ASSERT_TRUE(counters.getPresence().test(1));
+    ASSERT_FALSE(counters.getPresence().test(2));
+    ASSERT_TRUE(counters.hasTruncatedCounter());
+}
+
+TEST(CounterValuesTest, setFromRecord_whenLengthIsMultipleOf3_shouldNotReportTruncation) {
+    const uint8_t truncated[] = {0x00, 0x00, 0x0A, 0x00};
+    const uint8_t complete[] = {0x00, 0x00, 0x0A, 0x00, 0x00, 0x0B};
+    CounterValues counters;
+
+    ASSERT_FALSE(counters.hasTruncatedCounter());
+
+    counters.setFromRecord(truncated, sizeof(truncated));
+    counters.setFromRecord(complete, sizeof(complete));
+
+    ASSERT_EQ(counters.getCount(), 2u);
+    ASSERT_EQ(counters.getValue(2).get(), 11);
+    ASSERT_FALSE(counters.hasTruncatedCounter());
+}
+
+TEST(CounterValuesTest, setValue_shouldUpdateValueAndPresence) {
+    CounterValues counters;
+
+    counters.setValue(83, 42);
+
+    ASSERT_EQ(counters.getValues()[82], 42);
+    ASSERT_TRUE(counters.getValue(83).isPresent());
+}
+
+TEST(CounterValuesTest, getValue_whenCounterNumberOutOfRange_shouldThrow) {
+    const CounterValues counters;
+
+    EXPECT_THROW(counters.getValue(0), std::out_of_range);
+    EXPECT_THROW(counters.getValue(84), std::out_of_range);
+}
@@ -0,0 +1,48 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <stdexcept>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Calypso Card */
+#include "keypop/calypso/card/card/FileKey.hpp"
+
+using keypop::calypso::card::card::FileKey;
+
+TEST(FileKeyTest, ofSfi_whenOutOfRange_shouldThrowInvalidArgument) {
+    ASSERT_THROW(FileKey::ofSfi(0), std::invalid_argument);
+    ASSERT_THROW(FileKey::ofSfi(31), std::invalid_argument);
+}
+
+TEST(FileKeyTest, keysOfDifferentSpaces_shouldBeDistinct) {
+    ASSERT_NE(FileKey::ofSfi(0x07), FileKey::ofLid(0x07));
+    ASSERT_NE(FileKey::ofLid(FileKey::SV_LOAD_LOG), FileKey::svLoadLog());
+    ASSERT_NE(FileKey::svLoadLog(), FileKey::svDebitLog());
+    ASSERT_EQ(FileKey::ofLid(0x2010), FileKey::ofLid(0x2010));
+}
+
+TEST(FileKeyTest, ordering_shouldCompareSpaceThenId) {
+    ASSERT_TRUE(FileKey::ofSfi(0x1E) < FileKey::ofLid(0x0001));
+    ASSERT_TRUE(FileKey::ofLid(0xFFFF) < FileKey::svLoadLog());
+    ASSERT_TRUE(FileKey::ofSfi(0x07) < FileKey::ofSfi(0x08));
+    ASSERT_FALSE(FileKey::ofSfi(0x07) < FileKey::ofSfi(0x07));
+}
+
+TEST(FileKeyTest, of_shouldRestoreKeyFromSpaceAndId) {
+    const FileKey key = FileKey::of(static_cast<uint8_t>(FileKey::Space::LID), 0x2010);
+
+    ASSERT_EQ(key.getSpace(), FileKey::Space::LID);
+    ASSERT_EQ(key.getId(), 0x2010);
+    ASSERT_EQ(FileKey::of(2, FileKey::SV_DEBIT_LOG), FileKey::svDebitLog());
+    ASSERT_THROW(FileKey::of(0, 0x0100), std::invalid_argument);
+    ASSERT_THROW(FileKey::of(2, 2), std::invalid_argument);
+    ASSERT_THROW(FileKey::of(3, 0), std::invalid_argument);
+}
@@ -0,0 +1,48 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <cstdint>
+#include <stdexcept>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Calypso Card */
+#include "keypop/calypso/card/Optional.hpp"
+
+using keypop::calypso::card::Optional;
+
+TEST(OptionalTest, empty_shouldNotBePresent) {
+    const Optional<int> value = Optional<int>::empty();
+
+    ASSERT_FALSE(value.isPresent());
+    ASSERT_FALSE(static_cast<bool>(value));
+    ASSERT_EQ(value.orElse(-1), -1);
+}
+
+TEST(OptionalTest, get_whenEmpty_shouldThrowLogicError) {
+    const Optional<uint8_t> value;
+
+    EXPECT_THROW(value.get(), std::logic_error);
+}
+
+TEST(OptionalTest, of_shouldHoldValue) {
+    const Optional<uint16_t> value = Optional<uint16_t>::of(0x1234);
+
+    ASSERT_TRUE(value.isPresent());
+    ASSERT_EQ(value.get(), 0x1234);
+    ASSERT_EQ(value.orElse(0), 0x1234);
+}
+
+TEST(OptionalTest, of_withZero_shouldBePresent) {
+    const Optional<uint16_t> value = Optional<uint16_t>::of(0);
+
+    ASSERT_TRUE(value.isPresent());
+    ASSERT_EQ(value.get(), 0);
+}
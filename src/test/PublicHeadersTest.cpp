@@ -0,0 +1,97 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <type_traits>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Calypso Card (every public header, so that each one is compiled at least once) */
+#include "keypop/calypso/card/ArrayView.hpp"
+#include "keypop/calypso/card/CalypsoCardApiFactory.hpp"
+#include "keypop/calypso/card/CalypsoCardApiProperties.hpp"
+#include "keypop/calypso/card/GetDataTag.hpp"
+#include "keypop/calypso/card/Optional.hpp"
+#include "keypop/calypso/card/SelectFileControl.hpp"
+#include "keypop/calypso/card/WriteAccessLevel.hpp"
+#include "keypop/calypso/card/card/CalypsoCard.hpp"
+#include "keypop/calypso/card/card/CalypsoCardSelectionExtension.hpp"
+#include "keypop/calypso/card/card/CardChange.hpp"
+#include "keypop/calypso/card/card/CardImage.hpp"
+#include "keypop/calypso/card/card/CardSnapshot.hpp"
+#include "keypop/calypso/card/card/CounterValues.hpp"
+#include "keypop/calypso/card/card/DirectoryHeader.hpp"
+#include "keypop/calypso/card/card/ElementaryFile.hpp"
+#include "keypop/calypso/card/card/FileData.hpp"
+#include "keypop/calypso/card/card/FileHeader.hpp"
+#include "keypop/calypso/card/card/FileKey.hpp"
+#include "keypop/calypso/card/card/ReadAheadProfile.hpp"
+#include "keypop/calypso/card/card/SvDebitLogEntry.hpp"
+#include "keypop/calypso/card/card/SvDebitLogRecord.hpp"
+#include "keypop/calypso/card/card/SvLoadLogEntry.hpp"
+#include "keypop/calypso/card/card/SvLoadLogRecord.hpp"
+#include "keypop/calypso/card/transaction/AuditLogReader.hpp"
+#include "keypop/calypso/card/transaction/AuditLogRecord.hpp"
+#include "keypop/calypso/card/transaction/AuditLogWriter.hpp"
+#include "keypop/calypso/card/transaction/CardIOException.hpp"
+#include "keypop/calypso/card/transaction/CardImageCache.hpp"
+#include "keypop/calypso/card/transaction/CardRevokedException.hpp"
+#include "keypop/calypso/card/transaction/CardSignatureNotVerifiableException.hpp"
+#include "keypop/calypso/card/transaction/ChannelControl.hpp"
+#include "keypop/calypso/card/transaction/CryptoException.hpp"
+#include "keypop/calypso/card/transaction/CryptoIOException.hpp"
+#include "keypop/calypso/card/transaction/FreeTransactionManager.hpp"
+#include "keypop/calypso/card/transaction/InconsistentDataException.hpp"
+#include "keypop/calypso/card/transaction/InvalidCardSignatureException.hpp"
+#include "keypop/calypso/card/transaction/InvalidPinException.hpp"
+#include "keypop/calypso/card/transaction/ReaderIOException.hpp"
+#include "keypop/calypso/card/transaction/SearchCommandData.hpp"
+#include "keypop/calypso/card/transaction/SecureExtendedModeTransactionManager.hpp"
+#include "keypop/calypso/card/transaction/SecureRegularModeTransactionManager.hpp"
+#include "keypop/calypso/card/transaction/SecureSymmetricCryptoTransactionManager.hpp"
+#include "keypop/calypso/card/transaction/SecureTransactionManager.hpp"
+#include "keypop/calypso/card/transaction/SelectFileException.hpp"
+#include "keypop/calypso/card/transaction/SessionBufferOverflowException.hpp"
+#include "keypop/calypso/card/transaction/SessionBufferUsage.hpp"
+#include "keypop/calypso/card/transaction/SvAction.hpp"
+#include "keypop/calypso/card/transaction/SvOperation.hpp"
+#include "keypop/calypso/card/transaction/SymmetricCryptoSecuritySetting.hpp"
+#include "keypop/calypso/card/transaction/TransactionManager.hpp"
+#include "keypop/calypso/card/transaction/TransactionPlan.hpp"
+#include "keypop/calypso/card/transaction/UnauthorizedKeyException.hpp"
+#include "keypop/calypso/card/transaction/UnexpectedCommandStatusException.hpp"
+#include "keypop/calypso/card/transaction/spi/AsymmetricCryptoCardTransactionManagerFactory.hpp"
+#include "keypop/calypso/card/transaction/spi/CardTransactionCryptoExtension.hpp"
+#include "keypop/calypso/card/transaction/spi/CardTransactionExecutor.hpp"
+#include "keypop/calypso/card/transaction/spi/CardTransactionObserver.hpp"
+#include "keypop/calypso/card/transaction/spi/SymmetricCryptoCardTransactionManagerFactory.hpp"
+#include "keypop/calypso/card/transaction/spi/TransactionAuditSink.hpp"
+
+using keypop::calypso::card::CalypsoCardApiFactory;
+using keypop::calypso::card::transaction::FreeTransactionManager;
+using keypop::calypso::card::transaction::SecureExtendedModeTransactionManager;
+using keypop::calypso::card::transaction::SecureRegularModeTransactionManager;
+using keypop::calypso::card::transaction::SecureSymmetricCryptoTransactionManager;
+using keypop::calypso::card::transaction::SecureTransactionManager;
+using keypop::calypso::card::transaction::TransactionManager;
+
+TEST(PublicHeadersTest, factory_shouldBeAnAbstractInterface) {
+    ASSERT_TRUE(std::is_abstract<CalypsoCardApiFactory>::value);
+}
+
+TEST(PublicHeadersTest, transactionManagers_shouldFollowTheCalypsoHierarchy) {
+    ASSERT_TRUE((std::is_base_of<TransactionManager<FreeTransactionManager>,
+                                 FreeTransactionManager>::value));
+    ASSERT_TRUE((std::is_base_of<SecureTransactionManager<SecureRegularModeTransactionManager>,
+                                 SecureRegularModeTransactionManager>::value));
+    ASSERT_TRUE(
+        (std::is_base_of<
+            SecureSymmetricCryptoTransactionManager<SecureExtendedModeTransactionManager>,
+            SecureExtendedModeTransactionManager>::value));
+}
@@ -0,0 +1,206 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Calypso Card reference implementation */
+#include "ReferenceTransactionManager.hpp"
+
+using keypop::calypso::card::ArrayView;
+using keypop::calypso::card::transaction::ChannelControl;
+using keypop::calypso::card::transaction::spi::CardTransactionExecutor;
+using testing::ElementsAre;
+
+namespace {
+
+const uint8_t SFI_COUNTERS = 0x19;
+const uint8_t SFI_RECORDS = 0x07;
+const uint8_t CURRENT_EF = 0x00;
+
+/**
+ * Executor queuing the tasks until they are explicitly run.
+ */
+class QueueExecutor : public CardTransactionExecutor {
+public:
+    void
+    execute(const std::function<void()>& task) override {
+        mTasks.push_back(task);
+    }
+
+    void
+    runAll() {
+        while (!mTasks.empty()) {
+            const std::function<void()> task = mTasks.front();
+            mTasks.pop_front();
+            task();
+        }
+    }
+
+private:
+    std::deque<std::function<void()>> mTasks;
+};
+
+class ReferenceTransactionManagerTest : public testing::Test {
+protected:
+    ReferenceTransactionManagerTest()
+    : mSimulatedCard(std::make_shared<SimulatedCalypsoCard>())
+    , mCard(std::make_shared<ReferenceCalypsoCard>()) {
+        mSimulatedCard->addFile(SFI_COUNTERS, 1, 29);
+        mSimulatedCard->addFile(SFI_RECORDS, 2, 29);
+        mManager = std::make_shared<ReferenceTransactionManager>(
+            std::make_shared<SimulatedCardReader>("reader", mSimulatedCard), mCard);
+    }
+
+    /**
+     * Returns the counter numbers (P1) of the commands sent to the card, in order.
+     */
+    std::vector<int>
+    getTransmittedCounterNumbers() const {
+        std::vector<int> counterNumbers;
+        for (const auto& exchange : mManager->getTransactionAuditData()) {
+            if (exchange.size() > 2 && (exchange[1] == 0x32 || exchange[1] == 0x30)) {
+                counterNumbers.push_back(exchange[2]);
+            }
+        }
+
+        return counterNumbers;
+    }
+
+    /**
+     * Returns the P2 byte (SFI and addressing mode) of the commands sent to the card, in order.
+     */
+    std::vector<int>
+    getTransmittedP2() const {
+        std::vector<int> p2;
+        const std::vector<std::vector<uint8_t>>& auditData = mManager->getTransactionAuditData();
+        for (size_t i = 0; i < auditData.size(); i += 2) {
+            p2.push_back(auditData[i][3]);
+        }
+
+        return p2;
+    }
+
+    std::shared_ptr<SimulatedCalypsoCard> mSimulatedCard;
+    std::shared_ptr<ReferenceCalypsoCard> mCard;
+    std::shared_ptr<ReferenceTransactionManager> mManager;
+};
+
+} /* namespace */
+
+TEST_F(ReferenceTransactionManagerTest, prepareIncreaseCounters_shouldProcessInAscendingOrder) {
+    const std::vector<std::pair<int, int>> values = {{4, 2}, {1, 10}, {3, 7}};
+    mManager->prepareIncreaseCounters(SFI_COUNTERS, ArrayView<std::pair<int, int>>(values));
+    ASSERT_EQ(mManager->getPreparedApduCount(), 3);
+
+    mManager->processCommands(ChannelControl::KEEP_OPEN);
+
+    ASSERT_THAT(getTransmittedCounterNumbers(), ElementsAre(1, 3, 4));
+}
+
+TEST_F(ReferenceTransactionManagerTest, prepareDecreaseCounters_whenArrayIsEmpty_shouldThrow) {
+    const std::vector<std::pair<int, int>> values;
+    ASSERT_THROW(
+        mManager->prepareDecreaseCounters(SFI_COUNTERS, ArrayView<std::pair<int, int>>(values)),
+        std::invalid_argument);
+}
+
+TEST_F(ReferenceTransactionManagerTest, prepareIncreaseCounters_whenCounterRepeated_shouldThrow) {
+    const std::vector<std::pair<int, int>> values = {{3, 1}, {1, 1}, {3, 2}};
+    ASSERT_THROW(
+        mManager->prepareIncreaseCounters(SFI_COUNTERS, ArrayView<std::pair<int, int>>(values)),
+        std::invalid_argument);
+
+    /* Nothing is prepared when the array is rejected */
+    ASSERT_EQ(mManager->getPreparedApduCount(), 0);
+}
+
+TEST_F(ReferenceTransactionManagerTest, prepareIncreaseCounters_whenMapIsEmpty_shouldThrow) {
+    const std::map<const int, const int> values;
+    ASSERT_THROW(
+        mManager->prepareIncreaseCounters(SFI_COUNTERS, values), std::invalid_argument);
+}
+
+TEST_F(ReferenceTransactionManagerTest, prepareReadRecord_whenCurrentEf_shouldResolveItsSfi) {
+    mManager->prepareReadRecord(SFI_RECORDS, 1).prepareReadRecord(CURRENT_EF, 2);
+    mManager->processCommands(ChannelControl::KEEP_OPEN);
+
+    /* Both reads are sent and keyed with the SFI of the EF read first */
+    ASSERT_THAT(getTransmittedP2(), ElementsAre(SFI_RECORDS * 8 + 4, SFI_RECORDS * 8 + 4));
+    ASSERT_EQ(mCard->getFileBySfiPtr(SFI_RECORDS)->getDataPtr()->getAllRecordsContent().size(), 2U);
+    ASSERT_EQ(mCard->getFileBySfiPtr(CURRENT_EF), nullptr);
+}
+
+TEST_F(ReferenceTransactionManagerTest, prepareUpdateRecord_whenCurrentEf_shouldUpdateItsImage) {
+    const std::vector<uint8_t> content = {0x11, 0x22, 0x33};
+    mManager->prepareReadRecord(SFI_RECORDS, 1).prepareUpdateRecord(CURRENT_EF, 1, content);
+    mManager->processCommands(ChannelControl::KEEP_OPEN);
+
+    const std::vector<uint8_t> record
+        = mCard->getFileBySfiPtr(SFI_RECORDS)->getDataPtr()->getContent(1);
+    ASSERT_THAT(
+        std::vector<uint8_t>(record.begin(), record.begin() + 3), ElementsAre(0x11, 0x22, 0x33));
+}
+
+TEST_F(ReferenceTransactionManagerTest, prepareReadRecord_whenCurrentEfUnknown_shouldSkipImage) {
+    /* Without I/O, the commands are assumed successful */
+    mManager = std::make_shared<ReferenceTransactionManager>(nullptr, mCard);
+    mManager->prepareReadRecord(SFI_RECORDS, 1)
+        .prepareSelectFile(static_cast<uint16_t>(0x2010))
+        .prepareReadRecord(CURRENT_EF, 1)
+        .prepareUpdateRecord(CURRENT_EF, 1, std::vector<uint8_t>{0x11});
+    mManager->processCommands(ChannelControl::KEEP_OPEN);
+
+    /* The commands following the selection address the current EF as is */
+    ASSERT_THAT(
+        getTransmittedP2(), ElementsAre(SFI_RECORDS * 8 + 4, 0x00, CURRENT_EF + 4, CURRENT_EF + 4));
+    /* The update is not attributed to the EF accessed before the selection */
+    ASSERT_EQ(mCard->getFileBySfiPtr(CURRENT_EF), nullptr);
+    ASSERT_EQ(mCard->getFileBySfiPtr(SFI_RECORDS), nullptr);
+}
+
+TEST_F(ReferenceTransactionManagerTest, settersAndReset_whenAsyncInProgress_shouldThrow) {
+    const auto executor = std::make_shared<QueueExecutor>();
+    int nbCompletions = 0;
+    mManager->prepareReadRecord(SFI_RECORDS, 1);
+    mManager->processCommandsAsync(
+        ChannelControl::KEEP_OPEN, executor, [&nbCompletions](const std::exception_ptr) {
+            nbCompletions++;
+        });
+
+    ASSERT_THROW(mManager->processCommands(ChannelControl::KEEP_OPEN), std::logic_error);
+    ASSERT_THROW(mManager->reset(nullptr, mCard), std::logic_error);
+    ASSERT_THROW(mManager->setCardImageCache(nullptr), std::logic_error);
+    ASSERT_THROW(mManager->setTransactionObserver(nullptr), std::logic_error);
+    ASSERT_THROW(mManager->setTransactionAuditSink(nullptr), std::logic_error);
+    ASSERT_THROW(mManager->setTransactionAuditDataMaxSize(0), std::logic_error);
+
+    executor->runAll();
+
+    ASSERT_EQ(nbCompletions, 1);
+    ASSERT_NO_THROW(mManager->setTransactionAuditDataMaxSize(0).reset(nullptr, mCard));
+}
+
+TEST_F(ReferenceTransactionManagerTest, reset_whenSecureSessionOpen_shouldThrow) {
+    mManager->prepareOpenSecureSession(SFI_RECORDS, 1).processCommands(ChannelControl::KEEP_OPEN);
+    ASSERT_THROW(mManager->reset(nullptr, mCard), std::logic_error);
+
+    mManager->prepareCloseSecureSession(false).processCommands(ChannelControl::KEEP_OPEN);
+    ASSERT_NO_THROW(mManager->reset(nullptr, mCard));
+}
@@ -0,0 +1,75 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Calypso Card */
+#include "keypop/calypso/card/card/SvDebitLogEntry.hpp"
+#include "keypop/calypso/card/card/SvLoadLogEntry.hpp"
+
+using keypop::calypso::card::card::SvDebitLogEntry;
+using keypop::calypso::card::card::SvLoadLogEntry;
+using testing::ElementsAre;
+
+TEST(SvLogEntryTest, loadLogDecode_shouldDecodeAllFields) {
+    const std::vector<uint8_t> rawData = {0x12, 0x34, 0xF1, 0xAB, 0xF2, 0x00, 0x03, 0xE8,
+                                          0x00, 0x00, 0x64, 0x56, 0x78, 0xA1, 0xA2, 0xA3,
+                                          0xA4, 0x01, 0x02, 0x03, 0x00, 0x0C};
+
+    const SvLoadLogEntry entry = SvLoadLogEntry::decode(rawData);
+
+    ASSERT_THAT(entry.loadDate, ElementsAre(0x12, 0x34));
+    ASSERT_THAT(entry.freeData, ElementsAre(0xF1, 0xF2));
+    ASSERT_EQ(entry.kvc, 0xAB);
+    ASSERT_EQ(entry.balance, 1000);
+    ASSERT_EQ(entry.amount, 100);
+    ASSERT_THAT(entry.loadTime, ElementsAre(0x56, 0x78));
+    ASSERT_THAT(entry.samId, ElementsAre(0xA1, 0xA2, 0xA3, 0xA4));
+    ASSERT_EQ(entry.samTNum, 0x010203);
+    ASSERT_EQ(entry.svTNum, 12);
+}
+
+TEST(SvLogEntryTest, loadLogDecode_withNegativeBalance_shouldDecodeSignedValue) {
+    std::vector<uint8_t> rawData(SvLoadLogEntry::RAW_DATA_SIZE);
+    rawData[5] = 0xFF;
+    rawData[6] = 0xFF;
+    rawData[7] = 0xFE;
+
+    ASSERT_EQ(SvLoadLogEntry::decode(rawData).balance, -2);
+}
+
+TEST(SvLogEntryTest, loadLogDecode_whenTooShort_shouldThrowInvalidArgument) {
+    ASSERT_THROW(SvLoadLogEntry::decode(std::vector<uint8_t>(21)), std::invalid_argument);
+}
+
+TEST(SvLogEntryTest, debitLogDecode_shouldDecodeAllFields) {
+    const std::vector<uint8_t> rawData = {0xFF, 0x9C, 0x12, 0x34, 0x56, 0x78, 0xAB,
+                                          0xA1, 0xA2, 0xA3, 0xA4, 0x01, 0x02, 0x03,
+                                          0x00, 0x03, 0x84, 0x00, 0x0D};
+
+    const SvDebitLogEntry entry = SvDebitLogEntry::decode(rawData);
+
+    ASSERT_EQ(entry.amount, -100);
+    ASSERT_THAT(entry.debitDate, ElementsAre(0x12, 0x34));
+    ASSERT_THAT(entry.debitTime, ElementsAre(0x56, 0x78));
+    ASSERT_EQ(entry.kvc, 0xAB);
+    ASSERT_THAT(entry.samId, ElementsAre(0xA1, 0xA2, 0xA3, 0xA4));
+    ASSERT_EQ(entry.samTNum, 0x010203);
+    ASSERT_EQ(entry.balance, 900);
+    ASSERT_EQ(entry.svTNum, 13);
+}
+
+TEST(SvLogEntryTest, debitLogDecode_whenTooShort_shouldThrowInvalidArgument) {
+    ASSERT_THROW(SvDebitLogEntry::decode(std::vector<uint8_t>(18)), std::invalid_argument);
+}